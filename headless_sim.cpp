@@ -0,0 +1,387 @@
+// Symulacja bez okna: wiele przebiegów planszy równolegle, z prostym botem
+// zamiast gracza. Zbiera mapę ciepła kafelków (include/Heatmap.h) - każdy
+// wątek do swojej mapy, scalanej na końcu - i zapisuje ją do pliku .heat,
+// który gra pokazuje jako nakładkę (--heatmap plik.heat, klawisz F4).
+//
+//   headless_sim plansza.txt [-n PRZEBIEGI] [-t KROKI] [-j WATKI] [-s ZIARNO]
+//                            [-o plik.heat] [-a] [-g | -l]
+//     -a  dodaj wynik do istniejącego pliku (sumowanie wielu sesji)
+//     -g  bot z celem: idzie drogą z PathFinder do złota i z nim do skarbca
+//     -l  bot z wyprzedzeniem: na postoju sprawdza przyszłości (World.h)
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "include/Maze.h"
+#include "include/Simulation.h"
+#include "include/Heatmap.h"
+#include "include/PathFinder.h"
+#include "include/Random.h"
+#include "include/World.h"
+
+// Bot: stojąc wybiera losowy kierunek, w którym da się ruszyć; w trakcie
+// ślizgu czasem skręca (jak gracz, który wciska strzałkę w biegu)
+void botInput(GameState &game, Rng &rng)
+{
+    if (game.isMoving && rng.below(40) != 0)
+        return;
+    static const int DIR_X[4] = {0, 0, -1, 1};
+    static const int DIR_Y[4] = {-1, 1, 0, 0};
+
+    int cellX = posToCell(game.posPlayerX, PLAYER_WIDTH);
+    int cellY = posToCell(game.posPlayerY, PLAYER_HEIGHT);
+    int cell = cellY * game.maze.width + cellX;
+    int options[4], count = 0;
+    for (int d = 0; d < 4; ++d)
+        if (game.slideTargets[cell * 4 + d] != cell)
+            options[count++] = d;
+    if (count == 0)
+        return;
+    int d = options[rng.below(count)];
+    handleDirectionInput(game, DIR_X[d], DIR_Y[d]);
+}
+
+// Bot z celem: najbliższe (w linii prostej) złoto, a ze złotem skarbiec.
+// Drogę liczy PathFinder; bot skręca, gdy wchodzi na pole, na którym droga
+// zmienia kierunek, a nową drogę liczy dopiero, gdy zboczy albo dojdzie.
+struct PathBot
+{
+    PathFinder finder;
+    std::vector<int> path;
+    size_t step = 0; // indeks bieżącego pola w path
+    int waitTicks = 0; // po nieudanym planowaniu przez chwilę bot losowy
+};
+
+bool planBotPath(GameState &game, PathBot &bot, int cellX, int cellY)
+{
+    int goalX = VAULT_CELL_X, goalY = VAULT_CELL_Y;
+    if (!game.hasGold)
+    {
+        int best = -1;
+        for (int y = 0; y < game.maze.height; ++y)
+            for (int x = 0; x < game.maze.width; ++x)
+            {
+                int d = std::abs(x - cellX) + std::abs(y - cellY);
+                if (tileInfo(game.maze.at(x, y)).gold && (best < 0 || d < best))
+                {
+                    best = d;
+                    goalX = x;
+                    goalY = y;
+                }
+            }
+        if (best < 0)
+            return false;
+    }
+    bot.step = 0;
+    return bot.finder.findPath(cellX, cellY, goalX, goalY, bot.path) > 0;
+}
+
+void pathBotInput(GameState &game, PathBot &bot, Rng &rng)
+{
+    int cellX = posToCell(game.posPlayerX, PLAYER_WIDTH);
+    int cellY = posToCell(game.posPlayerY, PLAYER_HEIGHT);
+    int cell = cellY * game.maze.width + cellX;
+
+    if (bot.step + 1 < bot.path.size() && bot.path[bot.step + 1] == cell)
+        bot.step++;
+    bool onPath = bot.step + 1 < bot.path.size() && bot.path[bot.step] == cell;
+    if (!onPath && (bot.waitTicks > 0 || !planBotPath(game, bot, cellX, cellY)))
+    {
+        if (bot.waitTicks-- <= 0)
+            bot.waitTicks = SIM_TICK_RATE;
+        bot.path.clear();
+        botInput(game, rng);
+        return;
+    }
+
+    int next = bot.path[bot.step + 1];
+    int dirX = next % game.maze.width - cellX;
+    int dirY = next / game.maze.width - cellY;
+    if (!game.isMoving || dirX != game.dirCellX || dirY != game.dirCellY)
+        handleDirectionInput(game, dirX, dirY);
+}
+
+// Bot z wyprzedzeniem: na postoju i na każdym skrzyżowaniu zapisuje świat
+// i dla każdego kierunku rozgrywa LOOKAHEAD_ROLLOUTS przyszłości po
+// LOOKAHEAD_TICKS kroków (dalej jak bot losowy), po czym wybiera kierunek
+// z najlepszą średnią.
+const int LOOKAHEAD_ROLLOUTS = 8;
+const int LOOKAHEAD_TICKS = 3 * SIM_TICK_RATE;
+
+struct LookaheadBot
+{
+    TilePagePool pool;
+    WorldSave base;
+    std::vector<int> distance, queue; // BFS do oceny
+    int lastCell = -1;                // pole ostatniej decyzji
+};
+
+// Droga piesza od pola (x, y) do najbliższego pola spełniającego warunek
+// (BFS po kafelkach; plansze do symulacji są małe); -1, gdy brak
+template <typename Pred>
+int walkDistance(const GameState &game, LookaheadBot &bot, int x, int y, Pred isGoal)
+{
+    int width = game.maze.width, cells = width * game.maze.height;
+    bot.distance.assign(cells, -1);
+    bot.queue.assign(1, y * width + x);
+    bot.distance[y * width + x] = 0;
+    static const int STEP_X[4] = {0, 0, -1, 1};
+    static const int STEP_Y[4] = {-1, 1, 0, 0};
+    for (size_t head = 0; head < bot.queue.size(); ++head)
+    {
+        int cell = bot.queue[head];
+        int cx = cell % width, cy = cell / width;
+        if (isGoal(cx, cy))
+            return bot.distance[cell];
+        for (int d = 0; d < 4; ++d)
+        {
+            int nx = cx + STEP_X[d], ny = cy + STEP_Y[d];
+            if (nx < 0 || ny < 0 || nx >= width || ny >= game.maze.height)
+                continue;
+            int next = ny * width + nx;
+            if (bot.distance[next] >= 0 || isSolidTile(game.maze.at(nx, ny)))
+                continue;
+            bot.distance[next] = bot.distance[cell] + 1;
+            bot.queue.push_back(next);
+        }
+    }
+    return -1;
+}
+
+// Ocena stanu na końcu przyszłości: oddane złoto, złapania i postęp -
+// ze złotem odległość do skarbca, bez złota do najbliższego złota
+int futureValue(const GameState &game, LookaheadBot &bot)
+{
+    int value = 1000 * game.score - 100 * game.pantherHits;
+    int cellX = posToCell(game.posPlayerX, PLAYER_WIDTH);
+    int cellY = posToCell(game.posPlayerY, PLAYER_HEIGHT);
+    if (game.hasGold)
+    {
+        int d = walkDistance(game, bot, cellX, cellY, [](int x, int y)
+                             { return x == VAULT_CELL_X && y == VAULT_CELL_Y; });
+        value += 500 - 2 * (d < 0 ? 200 : d);
+    }
+    else
+    {
+        int d = walkDistance(game, bot, cellX, cellY, [&](int x, int y)
+                             { return tileInfo(game.maze.at(x, y)).gold; });
+        value -= 2 * (d < 0 ? 0 : d);
+    }
+    return value;
+}
+
+void lookaheadBotInput(GameState &game, LookaheadBot &bot, Rng &rng)
+{
+    static const int DIR_X[4] = {0, 0, -1, 1};
+    static const int DIR_Y[4] = {-1, 1, 0, 0};
+
+    int cellX = posToCell(game.posPlayerX, PLAYER_WIDTH);
+    int cellY = posToCell(game.posPlayerY, PLAYER_HEIGHT);
+    int cell = cellY * game.maze.width + cellX;
+    int options[4], count = 0;
+    bool junction = false;
+    for (int d = 0; d < 4; ++d)
+        if (game.slideTargets[cell * 4 + d] != cell)
+        {
+            options[count++] = d;
+            junction |= DIR_X[d] != 0 ? game.dirCellX == 0 : game.dirCellY == 0;
+        }
+    // W biegu decyzja tylko raz na skrzyżowaniu (jest wyjście w bok)
+    if (count == 0 || (game.isMoving && (!junction || cell == bot.lastCell)))
+        return;
+    bot.lastCell = cell;
+
+    if (!saveWorld(game, bot.base, bot.pool))
+    {
+        bot.pool.reset();
+        forgetTilePages(game);
+        if (!saveWorld(game, bot.base, bot.pool))
+            return;
+    }
+    // Przyszłości nie trafiają do mapy ciepła
+    TileHeatmap *heatmap = game.heatmap;
+    game.heatmap = nullptr;
+
+    int best = options[0];
+    long long bestTotal = 0;
+    for (int o = 0; o < count; ++o)
+    {
+        long long total = 0;
+        for (int r = 0; r < LOOKAHEAD_ROLLOUTS; ++r)
+        {
+            restoreWorld(game, bot.base, bot.pool);
+            handleDirectionInput(game, DIR_X[options[o]], DIR_Y[options[o]]);
+            for (int t = 0; t < LOOKAHEAD_TICKS; ++t)
+            {
+                stepSimulation(game);
+                botInput(game, rng);
+            }
+            total += futureValue(game, bot);
+        }
+        if (o == 0 || total > bestTotal)
+        {
+            best = options[o];
+            bestTotal = total;
+        }
+    }
+
+    restoreWorld(game, bot.base, bot.pool);
+    game.heatmap = heatmap;
+    handleDirectionInput(game, DIR_X[best], DIR_Y[best]);
+}
+
+int main(int argc, char *argv[])
+{
+    int runs = 1000;
+    int ticks = 60 * SIM_TICK_RATE; // minuta gry
+    int threads = (int)std::thread::hardware_concurrency();
+    uint64_t seed = 1;
+    std::string outPath = "heatmap.heat";
+    bool append = false;
+    bool pathBot = false;
+    bool lookaheadBot = false;
+    std::string levelPath;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char *a = argv[i];
+        if (!std::strcmp(a, "-n") && i + 1 < argc)
+            runs = std::atoi(argv[++i]);
+        else if (!std::strcmp(a, "-t") && i + 1 < argc)
+            ticks = std::atoi(argv[++i]);
+        else if (!std::strcmp(a, "-j") && i + 1 < argc)
+            threads = std::atoi(argv[++i]);
+        else if (!std::strcmp(a, "-s") && i + 1 < argc)
+            seed = std::strtoull(argv[++i], NULL, 10);
+        else if (!std::strcmp(a, "-o") && i + 1 < argc)
+            outPath = argv[++i];
+        else if (!std::strcmp(a, "-a"))
+            append = true;
+        else if (!std::strcmp(a, "-g"))
+            pathBot = true;
+        else if (!std::strcmp(a, "-l"))
+            lookaheadBot = true;
+        else
+            levelPath = a;
+    }
+
+    Maze level;
+    if (levelPath.empty() || !loadMazeFile(levelPath, level))
+    {
+        std::cerr << "Uzycie: headless_sim plansza.txt [-n PRZEBIEGI] [-t KROKI] [-j WATKI] [-s ZIARNO]\n"
+                     "                    [-o plik.heat] [-a] [-g | -l]\n";
+        return 1;
+    }
+    if (threads < 1)
+        threads = 1;
+
+    int width = 0;
+    for (int y = 0; y < mazeHeight(level); ++y)
+        width = std::max(width, mazeRowWidth(level, y));
+    int height = mazeHeight(level);
+
+    // Jedna mapa na wątek - w pętli symulacji zwykłe ++, bez synchronizacji
+    std::vector<TileHeatmap> shards(threads);
+    std::vector<long long> scores(threads, 0);
+    std::atomic<int> next(0);
+    std::atomic<bool> failed(false);
+    auto start = std::chrono::steady_clock::now();
+
+    auto worker = [&](int t)
+    {
+        TileHeatmap &heat = shards[t];
+        heat.reset(width, height);
+        Arena arena(levelArenaBytes(width, height, 1));
+        GameState game;
+        game.heatmap = &heat;
+        game.verbose = false;
+        PathBot bot;
+        if (pathBot)
+            bot.finder.build(level); // ściany się nie zmieniają - raz na wątek
+        LookaheadBot lookahead;
+        while (true)
+        {
+            int n = next.fetch_add(1);
+            if (n >= runs)
+                break;
+            if (!restartLevel(game, arena, level))
+            {
+                failed = true;
+                break;
+            }
+            // Każdy przebieg ma własny strumień, więc wynik nie zależy od liczby wątków
+            Rng rng(rngStreamSeed(seed, RNG_SIM_BOT, n));
+            bot.path.clear();
+            bot.waitTicks = 0;
+            lookahead.lastCell = -1;
+            for (int tick = 0; tick < ticks; ++tick)
+            {
+                if (pathBot)
+                    pathBotInput(game, bot, rng);
+                else if (lookaheadBot)
+                    lookaheadBotInput(game, lookahead, rng);
+                else
+                    botInput(game, rng);
+                stepSimulation(game);
+            }
+            heat.runs++;
+            scores[t] += game.score;
+        }
+    };
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t)
+        pool.push_back(std::thread(worker, t));
+    for (size_t t = 0; t < pool.size(); ++t)
+        pool[t].join();
+
+    if (failed)
+    {
+        std::cerr << "Plansza za duza dla symulacji" << std::endl;
+        return 1;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Scalanie map wątków (i ewentualnie poprzedniego pliku)
+    TileHeatmap total;
+    total.reset(width, height);
+    if (append && loadHeatmap(outPath, total) && (total.width != width || total.height != height))
+    {
+        std::cerr << "Plik " << outPath << " jest dla innej planszy" << std::endl;
+        return 1;
+    }
+    long long score = 0;
+    for (int t = 0; t < threads; ++t)
+    {
+        total.merge(shards[t]);
+        score += scores[t];
+    }
+    if (!saveHeatmap(outPath, total))
+    {
+        std::cerr << "Nie mozna zapisac: " << outPath << std::endl;
+        return 1;
+    }
+
+    std::cerr << "Przebiegi: " << runs << " x " << ticks << " krokow, czas: " << seconds << " s ("
+              << (double)runs * ticks / seconds / 1e6 << " mln krokow/s, watki: " << threads << ")\n"
+              << "Srednio oddanego zlota: " << (double)score / runs << "\n"
+              << "Razem w " << outPath << ": " << total.runs << " przebiegow, " << total.ticks << " krokow\n";
+
+    // Kafelki, na których pantera łapie najczęściej
+    std::vector<std::pair<uint32_t, int>> hits;
+    for (int i = 0; i < width * height; ++i)
+        if (total.get(HEAT_PANTHER_HITS, i % width, i / width))
+            hits.push_back(std::make_pair(total.get(HEAT_PANTHER_HITS, i % width, i / width), i));
+    std::sort(hits.rbegin(), hits.rend());
+    std::cerr << "Najczestsze zlapania przez pantere:";
+    for (size_t i = 0; i < hits.size() && i < 5; ++i)
+        std::cerr << " (" << hits[i].second % width << "," << hits[i].second / width << "): " << hits[i].first;
+    std::cerr << std::endl;
+    return 0;
+}
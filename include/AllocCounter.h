@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include <SDL2/SDL.h>
+
+// ----------------- LICZNIK ALOKACJI (tylko build debug) ---------
+// Liczy alokacje przez globalne operator new oraz przez SDL_malloc/calloc/realloc
+// (SDL i SDL_ttf). Podmienia operator new, więc dołączamy go tylko w jednym
+// pliku .cpp. W buildzie z -DNDEBUG wszystko się kompiluje do zera.
+
+#ifndef NDEBUG
+
+static std::atomic<unsigned long long> g_heapAllocations(0);
+
+void *operator new(size_t size)
+{
+    void *p = std::malloc(size ? size : 1);
+    if (!p)
+        throw std::bad_alloc();
+    g_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    return p;
+}
+
+void *operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void *p, size_t) noexcept
+{
+    std::free(p);
+}
+
+static SDL_malloc_func g_sdlMalloc;
+static SDL_calloc_func g_sdlCalloc;
+static SDL_realloc_func g_sdlRealloc;
+static SDL_free_func g_sdlFree;
+
+static void *SDLCALL countingSdlMalloc(size_t size)
+{
+    g_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    return g_sdlMalloc(size);
+}
+
+static void *SDLCALL countingSdlCalloc(size_t count, size_t size)
+{
+    g_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    return g_sdlCalloc(count, size);
+}
+
+static void *SDLCALL countingSdlRealloc(void *p, size_t size)
+{
+    g_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    return g_sdlRealloc(p, size);
+}
+
+// Wołać przed SDL_Init (SDL nie może mieć jeszcze nic zaalokowanego)
+inline void installAllocationCounter()
+{
+    SDL_GetMemoryFunctions(&g_sdlMalloc, &g_sdlCalloc, &g_sdlRealloc, &g_sdlFree);
+    SDL_SetMemoryFunctions(countingSdlMalloc, countingSdlCalloc, countingSdlRealloc, g_sdlFree);
+}
+
+inline unsigned long long heapAllocations()
+{
+    return g_heapAllocations.load(std::memory_order_relaxed);
+}
+
+#else
+
+inline void installAllocationCounter() {}
+inline unsigned long long heapAllocations() { return 0; }
+
+#endif
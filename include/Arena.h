@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+
+// ----------------- ARENA (alokator "bump") ---------
+// Jeden blok pamięci przydzielony raz na starcie; alokacja to przesunięcie
+// wskaźnika, zwolnienie wszystkiego naraz to reset(). Używane dla danych
+// poziomu (restart = reset areny) i dla danych tymczasowych jednej klatki.
+// Destruktory nie są wołane, więc trzymamy tu tylko typy trywialne.
+class Arena
+{
+public:
+    explicit Arena(size_t capacity)
+        : base((uint8_t *)std::malloc(capacity)), capacity(base ? capacity : 0)
+    {
+    }
+    ~Arena()
+    {
+        std::free(base);
+    }
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    // nullptr, gdy arena jest pełna
+    void *allocate(size_t size, size_t align = alignof(std::max_align_t))
+    {
+        size_t start = (used + align - 1) & ~(align - 1);
+        if (start + size > capacity)
+            return nullptr;
+        used = start + size;
+        if (used > highWater)
+            highWater = used;
+        return base + start;
+    }
+
+    template <typename T>
+    T *allocArray(size_t count)
+    {
+        static_assert(std::is_trivially_destructible<T>::value, "arena nie wola destruktorow");
+        T *items = (T *)allocate(sizeof(T) * count, alignof(T));
+        if (items)
+        {
+            for (size_t i = 0; i < count; ++i)
+                new (&items[i]) T();
+        }
+        return items;
+    }
+
+    // Zapamiętanie i cofnięcie stanu (np. dane tymczasowe w środku klatki)
+    size_t mark() const { return used; }
+    void rewind(size_t mark) { used = mark; }
+
+    void reset() { used = 0; }
+
+    size_t bytesUsed() const { return used; }
+    size_t bytesCapacity() const { return capacity; }
+    size_t bytesHighWater() const { return highWater; }
+
+private:
+    uint8_t *base;
+    size_t capacity;
+    size_t used = 0;
+    size_t highWater = 0;
+};
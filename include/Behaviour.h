@@ -0,0 +1,163 @@
+#pragma once
+
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+
+#include "Arena.h"
+
+// ----------------- ZACHOWANIA JAKO COROUTINES (C++20) ---------
+// Zachowanie (patrol pantery, "wyłączona na N kroków", zdarzenie poziomu) to
+// zwykła funkcja z co_await sleepTicks(...) zamiast ręcznego licznika
+// sprawdzanego w każdym kroku. Uśpione zachowanie leży w kole czasu
+// (timer wheel) w przegródce swojego kroku budzenia i nic nie kosztuje,
+// dopóki koło do niej nie dojdzie - krok symulacji budzi tylko te, których
+// czas nadszedł, bez przeglądania wszystkich.
+//
+// Ramki coroutines są w arenie poziomu: pierwszy parametr zachowania to
+// Arena&. Jak wszystko w arenie, ramki nie są niszczone - restart poziomu to
+// reset areny, więc w zachowaniach trzymamy tylko zmienne trywialne.
+
+// Liczba przegródek koła (potęga dwójki); dłuższe uśpienie po prostu
+// przechodzi przez swoją przegródkę więcej niż raz
+const int BEHAVIOUR_WHEEL_SLOTS = 256;
+
+struct BehaviourPromise;
+typedef std::coroutine_handle<BehaviourPromise> BehaviourHandle;
+
+// Uchwyt zwracany przez coroutine zachowania (pusty, gdy arena była pełna)
+struct Behaviour
+{
+    typedef BehaviourPromise promise_type;
+    BehaviourHandle handle;
+};
+
+struct BehaviourPromise
+{
+    uint32_t wakeTick = 0;
+    BehaviourPromise *next = nullptr; // lista w przegródce koła
+
+    template <typename... Args>
+    static void *operator new(size_t size, Arena &arena, Args &&...) noexcept
+    {
+        return arena.allocate(size);
+    }
+    static void operator delete(void *) noexcept
+    {
+        // pamięć oddaje reset areny
+    }
+    static Behaviour get_return_object_on_allocation_failure()
+    {
+        return Behaviour();
+    }
+
+    Behaviour get_return_object()
+    {
+        return Behaviour{BehaviourHandle::from_promise(*this)};
+    }
+    // Start dopiero z koła (spawn), koniec bez niszczenia ramki
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    std::suspend_always final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+};
+
+// Koło czasu: przegródka = numer kroku & (BEHAVIOUR_WHEEL_SLOTS - 1),
+// w przegródce lista FIFO (kolejność budzenia = kolejność uśpienia)
+struct BehaviourScheduler
+{
+    BehaviourPromise **heads = nullptr;
+    BehaviourPromise **tails = nullptr;
+    uint32_t now = 0;  // bieżący krok
+    int sleeping = 0;  // ile zachowań czeka w kole
+
+    bool init(Arena &arena)
+    {
+        heads = arena.allocArray<BehaviourPromise *>(BEHAVIOUR_WHEEL_SLOTS);
+        tails = arena.allocArray<BehaviourPromise *>(BEHAVIOUR_WHEEL_SLOTS);
+        now = 0;
+        sleeping = 0;
+        return heads && tails;
+    }
+
+    // Puste koło (ramki zostają w arenie); przed odbudową po przywróceniu stanu
+    void clear(uint32_t tick)
+    {
+        for (int i = 0; i < BEHAVIOUR_WHEEL_SLOTS; ++i)
+            heads[i] = tails[i] = nullptr;
+        now = tick;
+        sleeping = 0;
+    }
+
+    // Start zachowania w bieżącym kroku; false, gdy zabrakło miejsca na ramkę
+    bool spawn(Behaviour behaviour)
+    {
+        if (!behaviour.handle)
+            return false;
+        schedule(behaviour.handle, 0);
+        return true;
+    }
+
+    void schedule(BehaviourHandle handle, uint32_t delay)
+    {
+        BehaviourPromise &p = handle.promise();
+        p.wakeTick = now + delay;
+        append(p.wakeTick & (BEHAVIOUR_WHEEL_SLOTS - 1), &p);
+        sleeping++;
+    }
+
+    // Jeden krok: wznawia zachowania, których czas nadszedł
+    void runTick()
+    {
+        int slot = now & (BEHAVIOUR_WHEEL_SLOTS - 1);
+        BehaviourPromise *p = heads[slot];
+        heads[slot] = tails[slot] = nullptr;
+        while (p)
+        {
+            BehaviourPromise *next = p->next; // resume może wpisać p do innej listy
+            if ((int32_t)(p->wakeTick - now) <= 0)
+            {
+                sleeping--;
+                BehaviourHandle::from_promise(*p).resume();
+            }
+            else
+            {
+                append(slot, p); // budzi się w kolejnym obrocie koła
+            }
+            p = next;
+        }
+        now++;
+    }
+
+private:
+    void append(int slot, BehaviourPromise *p)
+    {
+        p->next = nullptr;
+        if (tails[slot])
+            tails[slot]->next = p;
+        else
+            heads[slot] = p;
+        tails[slot] = p;
+    }
+};
+
+// co_await sleepTicks(scheduler, n) - wznowienie n kroków później (0 = bez czekania)
+struct SleepTicks
+{
+    BehaviourScheduler &scheduler;
+    uint32_t ticks;
+
+    bool await_ready() const noexcept { return ticks == 0; }
+    void await_suspend(BehaviourHandle handle) { scheduler.schedule(handle, ticks); }
+    void await_resume() const noexcept {}
+};
+
+inline SleepTicks sleepTicks(BehaviourScheduler &scheduler, uint32_t ticks)
+{
+    return SleepTicks{scheduler, ticks};
+}
+
+inline SleepTicks nextTick(BehaviourScheduler &scheduler)
+{
+    return SleepTicks{scheduler, 1};
+}
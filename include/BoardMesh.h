@@ -0,0 +1,265 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <SDL2/SDL.h>
+
+// ----------------- SIATKA PLANSZY W KAWAŁKACH ---------
+// Plansza dzielona jest na kawałki BOARD_MESH_CHUNK x BOARD_MESH_CHUNK
+// kafelków; każdy kawałek ma własną listę czworokątów (wierzchołki +
+// indeksy) i kopię swoich kafelków. Przy zmianie planszy budujemy od nowa
+// tylko kawałki, w których zmienił się jakiś kafelek - kilka naraz na
+// wątkach puli, jeden albo dwa (zebrane złoto) od razu w wątku renderowania.
+// Potem kawałki są sklejane w jedną listę i cała plansza idzie jednym
+// SDL_RenderGeometry na klatkę.
+//
+// Każdy prostokąt to 4 wierzchołki i 6 indeksów w kolejności, którą
+// software renderer SDL rozpoznaje jako prostokąt (te same piksele co
+// SDL_RenderFillRects, test --render-test tego pilnuje).
+//
+// Wątki puli śpią na atomiku (wait/notify) między partiami, więc
+// nieruchoma plansza nie kosztuje nic poza jednym wywołaniem rysowania.
+
+const int BOARD_MESH_CHUNK = 8;
+
+// Mniej brudnych kawałków budujemy w wątku renderowania (pobudka puli
+// kosztuje więcej niż kilkaset prostokątów)
+const int BOARD_MESH_PARALLEL_MIN_CHUNKS = 3;
+
+const int BOARD_MESH_MAX_WORKERS = 7;
+
+// Prostokąty jednego kawałka; add() ma ten sam kształt co RectBatcher::add,
+// więc kod rysujący kafelki działa z oboma
+struct BoardQuads
+{
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices; // względem początku kawałka
+
+    void clear()
+    {
+        vertices.clear();
+        indices.clear();
+    }
+
+    void add(SDL_Color color, const SDL_Rect &rect)
+    {
+        int base = (int)vertices.size();
+        float x0 = (float)rect.x, y0 = (float)rect.y;
+        float x1 = (float)(rect.x + rect.w), y1 = (float)(rect.y + rect.h);
+        vertices.push_back({{x0, y0}, color, {0.0f, 0.0f}});
+        vertices.push_back({{x1, y0}, color, {0.0f, 0.0f}});
+        vertices.push_back({{x1, y1}, color, {0.0f, 0.0f}});
+        vertices.push_back({{x0, y1}, color, {0.0f, 0.0f}});
+        const int order[6] = {0, 1, 2, 0, 2, 3};
+        for (int i = 0; i < 6; ++i)
+            indices.push_back(base + order[i]);
+    }
+};
+
+// Rysuje jeden kafelek (wartość z planszy) z lewym górnym rogiem w (x, y);
+// wołana z wątków puli - nie może dotykać niczego poza quads
+typedef void (*BoardTileEmitter)(BoardQuads &quads, uint8_t tile, int x, int y);
+
+// Wątki dla siatki: rdzenie poza wątkiem renderowania i symulacji
+inline int boardMeshWorkers()
+{
+    int cores = (int)std::thread::hardware_concurrency();
+    return std::clamp(cores - 2, 0, BOARD_MESH_MAX_WORKERS);
+}
+
+class BoardMesh
+{
+public:
+    explicit BoardMesh(int workerCount)
+    {
+        for (int i = 0; i < workerCount; ++i)
+            workers.push_back(std::thread(&BoardMesh::workerLoop, this));
+    }
+
+    ~BoardMesh()
+    {
+        stopping = true;
+        generation.fetch_add(1);
+        generation.notify_all();
+        for (size_t i = 0; i < workers.size(); ++i)
+            workers[i].join();
+    }
+
+    // Kafelki w wierszach co stride bajtów; version - licznik zmian planszy
+    // (ta sama wersja i wymiary - nic do roboty, bez porównywania kafelków)
+    void update(const uint8_t *tiles, int stride, int width, int height, int tileSize, uint32_t version,
+                BoardTileEmitter emitTile)
+    {
+        if (width != boardWidth || height != boardHeight || tileSize != cellSize || emitTile != emit)
+        {
+            boardWidth = width;
+            boardHeight = height;
+            cellSize = tileSize;
+            emit = emitTile;
+            chunksX = (width + BOARD_MESH_CHUNK - 1) / BOARD_MESH_CHUNK;
+            chunksY = (height + BOARD_MESH_CHUNK - 1) / BOARD_MESH_CHUNK;
+            chunks.resize((size_t)chunksX * chunksY);
+            for (size_t i = 0; i < chunks.size(); ++i)
+                chunks[i].valid = false;
+            jobs.resize(chunks.size());
+        }
+        else if (version == builtVersion)
+        {
+            return;
+        }
+        builtVersion = version;
+
+        // Brudne kawałki: porównanie z kopią kafelków kawałka
+        int dirty = 0;
+        for (int cy = 0; cy < chunksY; ++cy)
+        {
+            for (int cx = 0; cx < chunksX; ++cx)
+            {
+                Chunk &c = chunks[cy * chunksX + cx];
+                c.x = cx * BOARD_MESH_CHUNK;
+                c.y = cy * BOARD_MESH_CHUNK;
+                c.w = std::min(BOARD_MESH_CHUNK, width - c.x);
+                c.h = std::min(BOARD_MESH_CHUNK, height - c.y);
+                bool same = c.valid;
+                for (int y = 0; y < c.h; ++y)
+                {
+                    const uint8_t *row = tiles + (size_t)(c.y + y) * stride + c.x;
+                    if (same && std::memcmp(c.tiles[y], row, c.w) == 0)
+                        continue;
+                    same = false;
+                    std::memcpy(c.tiles[y], row, c.w);
+                }
+                if (!same)
+                    jobs[dirty++] = cy * chunksX + cx;
+            }
+        }
+        if (dirty == 0)
+            return;
+
+        if (dirty < BOARD_MESH_PARALLEL_MIN_CHUNKS || workers.empty())
+        {
+            for (int j = 0; j < dirty; ++j)
+                buildChunk(chunks[jobs[j]]);
+        }
+        else
+        {
+            // jobs i parametry są gotowe przed ogłoszeniem partii; numery
+            // zadań niosą numer partii (batch << 32 | zadanie), więc wątek
+            // spóźniony z poprzedniej partii nie weźmie zadania z nowej
+            uint64_t batch = ++batchNumber;
+            pending.store(dirty);
+            batchJobs.store(batch << 32 | (uint32_t)dirty);
+            nextJob.store(batch << 32);
+            generation.fetch_add(1);
+            generation.notify_all();
+            runJobs();
+            for (int left = pending.load(); left != 0; left = pending.load())
+                pending.wait(left);
+            parallelBuilds++;
+        }
+        chunkBuilds += dirty;
+        merge();
+    }
+
+    void draw(SDL_Renderer *renderer) const
+    {
+        if (!indices.empty())
+            SDL_RenderGeometry(renderer, NULL, vertices.data(), (int)vertices.size(), indices.data(),
+                               (int)indices.size());
+    }
+
+    int workerCount() const { return (int)workers.size(); }
+    int quadCount() const { return (int)indices.size() / 6; }
+    uint64_t chunksBuilt() const { return chunkBuilds; }
+    uint64_t parallelBatches() const { return parallelBuilds; }
+
+private:
+    struct Chunk
+    {
+        int x = 0, y = 0, w = 0, h = 0; // w kafelkach
+        bool valid = false;
+        uint8_t tiles[BOARD_MESH_CHUNK][BOARD_MESH_CHUNK];
+        BoardQuads quads;
+    };
+
+    void buildChunk(Chunk &c)
+    {
+        c.quads.clear();
+        for (int y = 0; y < c.h; ++y)
+            for (int x = 0; x < c.w; ++x)
+                emit(c.quads, c.tiles[y][x], (c.x + x) * cellSize, (c.y + y) * cellSize);
+        c.valid = true;
+    }
+
+    void runJobs()
+    {
+        // batchJobs jest zapisywane przed nextJob, więc po pobraniu numeru
+        // widzimy co najmniej jego partię; inna partia - numer nieważny
+        while (true)
+        {
+            uint64_t ticket = nextJob.fetch_add(1);
+            uint64_t current = batchJobs.load();
+            if (ticket >> 32 != current >> 32 || (uint32_t)ticket >= (uint32_t)current)
+                return;
+            buildChunk(chunks[jobs[(uint32_t)ticket]]);
+            if (pending.fetch_sub(1) == 1)
+                pending.notify_one();
+        }
+    }
+
+    void workerLoop()
+    {
+        uint32_t seen = 0;
+        while (true)
+        {
+            generation.wait(seen);
+            seen = generation.load();
+            if (stopping)
+                return;
+            runJobs();
+        }
+    }
+
+    // Sklejenie kawałków w jedną listę (tylko po zmianie; pamięć zostaje
+    // na kolejne klatki)
+    void merge()
+    {
+        vertices.clear();
+        indices.clear();
+        for (size_t i = 0; i < chunks.size(); ++i)
+        {
+            const BoardQuads &q = chunks[i].quads;
+            int base = (int)vertices.size();
+            vertices.insert(vertices.end(), q.vertices.begin(), q.vertices.end());
+            for (size_t k = 0; k < q.indices.size(); ++k)
+                indices.push_back(base + q.indices[k]);
+        }
+    }
+
+    int boardWidth = 0, boardHeight = 0, cellSize = 0;
+    int chunksX = 0, chunksY = 0;
+    uint32_t builtVersion = ~0u;
+    BoardTileEmitter emit = nullptr;
+    std::vector<Chunk> chunks;
+
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+
+    // Partia dla puli: numery brudnych kawałków w jobs[0..liczba zadań);
+    // batchJobs = partia << 32 | liczba zadań, nextJob = partia << 32 | następne
+    std::vector<int> jobs;
+    uint64_t batchNumber = 0;
+    std::atomic<uint64_t> batchJobs{0};
+    std::atomic<uint64_t> nextJob{0};
+    std::atomic<int> pending{0};
+    std::atomic<uint32_t> generation{0};
+    std::atomic<bool> stopping{false};
+    std::vector<std::thread> workers;
+
+    uint64_t chunkBuilds = 0, parallelBuilds = 0;
+};
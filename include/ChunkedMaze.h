@@ -0,0 +1,314 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "Maze.h"
+#include "Tiles.h"
+
+// ----------------- DUŻE PLANSZE: KAFELKI W KAWAŁKACH ---------
+// Plansza podzielona na kawałki 32x32 kafelki, każdy spakowany po 4 bity na
+// kafelek (512 bajtów zamiast 4 KB w Maze). Kawałki w całości ze ściany nie
+// zajmują pamięci - wszystkie wskazują na jeden wspólny kawałek (nr 0).
+// Odczyt i zapis idą przez mały cache LRU rozpakowanych kawałków, więc pola
+// wokół gracza i kamery kosztują tyle, co zwykła tablica bajtów; prefetch()
+// rozpakowuje je zawczasu. Pamięć na planszę N kafelków: ~N/2 bajtów dla
+// kawałków z przejściami + 4 bajty na kawałek + stały cache.
+// Cache jest częścią obiektu, więc jeden ChunkedMaze = jeden wątek.
+
+const int CHUNK_SHIFT = 5;
+const int CHUNK_SIZE = 1 << CHUNK_SHIFT; // 32
+const int CHUNK_TILES = CHUNK_SIZE * CHUNK_SIZE;
+const int CHUNK_PACKED_BYTES = CHUNK_TILES / 2;
+
+// Rozpakowane kawałki w pamięci; 16 = okno 4x4 kawałki (128x128 kafelków)
+const int CHUNK_CACHE_SLOTS = 16;
+
+// Wartość kafelka musi zmieścić się w 4 bitach
+const int CHUNK_MAX_TILE_VALUE = 15;
+
+class ChunkedMaze
+{
+public:
+    ChunkedMaze()
+    {
+        create(0, 0);
+    }
+
+    // Nowa plansza w całości ze ściany
+    void create(int w, int h)
+    {
+        width = w;
+        height = h;
+        chunksX = (w + CHUNK_SIZE - 1) >> CHUNK_SHIFT;
+        chunksY = (h + CHUNK_SIZE - 1) >> CHUNK_SHIFT;
+        chunkRef.assign((size_t)chunksX * chunksY, 0);
+        freePacked.clear();
+        packed.assign(CHUNK_PACKED_BYTES, (uint8_t)((TILE_WALL << 4) | TILE_WALL));
+        for (int i = 0; i < CHUNK_CACHE_SLOTS; ++i)
+        {
+            slots[i].chunk = -1;
+            slots[i].lastUse = 0;
+            slots[i].dirty = false;
+        }
+        lastSlot = 0;
+        useClock = 0;
+        hits = misses = 0;
+    }
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+    // Poza planszą jest ściana (jak krótsze rzędy w initGameState)
+    uint8_t get(int x, int y) const
+    {
+        if (x < 0 || y < 0 || x >= width || y >= height)
+            return TILE_WALL;
+        const Slot &s = slotFor(x, y);
+        return s.tiles[((y & (CHUNK_SIZE - 1)) << CHUNK_SHIFT) | (x & (CHUNK_SIZE - 1))];
+    }
+
+    void set(int x, int y, uint8_t value)
+    {
+        if (x < 0 || y < 0 || x >= width || y >= height)
+            return;
+        Slot &s = slotFor(x, y);
+        s.tiles[((y & (CHUNK_SIZE - 1)) << CHUNK_SHIFT) | (x & (CHUNK_SIZE - 1))] = value & 0x0F;
+        s.dirty = true;
+    }
+
+    // Rozpakowanie kawałków w promieniu (w kafelkach) wokół punktu - np. gracza
+    // albo środka kamery - zanim zapyta o nie logika lub rysowanie
+    void prefetch(int x, int y, int radius) const
+    {
+        int cx0 = (x - radius) >> CHUNK_SHIFT, cx1 = (x + radius) >> CHUNK_SHIFT;
+        int cy0 = (y - radius) >> CHUNK_SHIFT, cy1 = (y + radius) >> CHUNK_SHIFT;
+        for (int cy = cy0 < 0 ? 0 : cy0; cy <= cy1 && cy < chunksY; ++cy)
+            for (int cx = cx0 < 0 ? 0 : cx0; cx <= cx1 && cx < chunksX; ++cx)
+                slotFor(cx << CHUNK_SHIFT, cy << CHUNK_SHIFT);
+    }
+
+    // Zapisanie całego kawałka naraz (wczytywanie pliku, generator);
+    // tiles to CHUNK_TILES wartości rzędami po CHUNK_SIZE
+    void storeChunk(int cx, int cy, const uint8_t *tiles)
+    {
+        int chunk = cy * chunksX + cx;
+        for (int i = 0; i < CHUNK_CACHE_SLOTS; ++i)
+            if (slots[i].chunk == chunk)
+            {
+                slots[i].chunk = -1; // nieaktualny
+                slots[i].dirty = false;
+            }
+        pack(chunk, tiles);
+    }
+
+    // Zapis zmienionych kawałków z cache do postaci spakowanej
+    void flush()
+    {
+        for (int i = 0; i < CHUNK_CACHE_SLOTS; ++i)
+            if (slots[i].chunk >= 0 && slots[i].dirty)
+            {
+                pack(slots[i].chunk, slots[i].tiles);
+                slots[i].dirty = false;
+            }
+    }
+
+    // ----- statystyki -----
+    size_t memoryBytes() const
+    {
+        return packed.capacity() + chunkRef.capacity() * sizeof(uint32_t) +
+               freePacked.capacity() * sizeof(uint32_t) + sizeof(*this);
+    }
+
+    int chunkCount() const { return chunksX * chunksY; }
+
+    // Kawałki z własnymi danymi (reszta to wspólna ściana)
+    int storedChunks() const
+    {
+        return (int)(packed.size() / CHUNK_PACKED_BYTES) - 1 - (int)freePacked.size();
+    }
+
+    uint64_t cacheHits() const { return hits; }
+    uint64_t cacheMisses() const { return misses; }
+
+private:
+    struct Slot
+    {
+        int chunk;
+        uint32_t lastUse;
+        bool dirty;
+        uint8_t tiles[CHUNK_TILES];
+    };
+
+    Slot &slotFor(int x, int y) const
+    {
+        int chunk = (y >> CHUNK_SHIFT) * chunksX + (x >> CHUNK_SHIFT);
+        // Najczęściej pytamy wielokrotnie o ten sam kawałek (ślizg, rysowanie rzędu)
+        if (slots[lastSlot].chunk == chunk)
+        {
+            hits++;
+            return slots[lastSlot];
+        }
+        int victim = 0;
+        for (int i = 0; i < CHUNK_CACHE_SLOTS; ++i)
+        {
+            if (slots[i].chunk == chunk)
+            {
+                hits++;
+                slots[i].lastUse = ++useClock;
+                lastSlot = i;
+                return slots[i];
+            }
+            if (slots[i].lastUse < slots[victim].lastUse)
+                victim = i;
+        }
+
+        misses++;
+        Slot &s = slots[victim];
+        if (s.chunk >= 0 && s.dirty)
+            const_cast<ChunkedMaze *>(this)->pack(s.chunk, s.tiles);
+        unpack(chunk, s.tiles);
+        s.chunk = chunk;
+        s.dirty = false;
+        s.lastUse = ++useClock;
+        lastSlot = victim;
+        return s;
+    }
+
+    void unpack(int chunk, uint8_t *tiles) const
+    {
+        const uint8_t *src = &packed[(size_t)chunkRef[chunk] * CHUNK_PACKED_BYTES];
+        for (int i = 0; i < CHUNK_PACKED_BYTES; ++i)
+        {
+            tiles[i * 2] = src[i] & 0x0F;
+            tiles[i * 2 + 1] = src[i] >> 4;
+        }
+    }
+
+    // Kawałek z samą ścianą wraca do wspólnego; inny dostaje własne miejsce
+    void pack(int chunk, const uint8_t *tiles)
+    {
+        bool allWall = true;
+        for (int i = 0; i < CHUNK_TILES && allWall; ++i)
+            allWall = tiles[i] == TILE_WALL;
+
+        uint32_t &ref = chunkRef[chunk];
+        if (allWall)
+        {
+            if (ref != 0)
+                freePacked.push_back(ref);
+            ref = 0;
+            return;
+        }
+        if (ref == 0)
+        {
+            if (!freePacked.empty())
+            {
+                ref = freePacked.back();
+                freePacked.pop_back();
+            }
+            else
+            {
+                ref = (uint32_t)(packed.size() / CHUNK_PACKED_BYTES);
+                packed.resize(packed.size() + CHUNK_PACKED_BYTES);
+            }
+        }
+        uint8_t *dst = &packed[(size_t)ref * CHUNK_PACKED_BYTES];
+        for (int i = 0; i < CHUNK_PACKED_BYTES; ++i)
+            dst[i] = (uint8_t)((tiles[i * 2] & 0x0F) | ((tiles[i * 2 + 1] & 0x0F) << 4));
+    }
+
+    int width = 0, height = 0;
+    int chunksX = 0, chunksY = 0;
+    std::vector<uint32_t> chunkRef;   // [cy * chunksX + cx] -> nr kawałka w packed (0 = ściana)
+    std::vector<uint8_t> packed;      // kawałki po CHUNK_PACKED_BYTES, nr 0 to wspólna ściana
+    std::vector<uint32_t> freePacked; // zwolnione miejsca (kawałki, które stały się ścianą)
+
+    mutable Slot slots[CHUNK_CACHE_SLOTS];
+    mutable int lastSlot = 0;
+    mutable uint32_t useClock = 0;
+    mutable uint64_t hits = 0, misses = 0;
+};
+
+// Wspólny dostęp jak dla Maze i TileGrid (computeTargetCell, initGameState)
+inline int mazeHeight(const ChunkedMaze &maze) { return maze.getHeight(); }
+inline int mazeRowWidth(const ChunkedMaze &maze, int) { return maze.getWidth(); }
+inline int tileAt(const ChunkedMaze &maze, int x, int y) { return maze.get(x, y); }
+
+// Liczby z jednej linii pliku w formacie loadMazeFile
+inline int parseMazeLine(const std::string &line, uint8_t *out, int maxCount, bool &tooBig)
+{
+    int count = 0;
+    for (size_t i = 0; i < line.size(); ++i)
+    {
+        if (line[i] >= '0' && line[i] <= '9')
+        {
+            int v = 0;
+            while (i < line.size() && line[i] >= '0' && line[i] <= '9')
+                v = v * 10 + (line[i++] - '0');
+            if (v > CHUNK_MAX_TILE_VALUE)
+                tooBig = true;
+            if (out && count < maxCount)
+                out[count] = (uint8_t)v;
+            count++;
+        }
+    }
+    return count;
+}
+
+// Wczytanie pliku planszy prosto do kawałków, bez pełnej kopii w Maze:
+// pierwsze przejście liczy wymiary, drugie czyta pas 32 rzędów naraz.
+// Krótsze rzędy dopełniamy ścianami. false także dla wartości > 15.
+inline bool loadChunkedMazeFile(const std::string &path, ChunkedMaze &maze)
+{
+    std::ifstream in(path.c_str());
+    if (!in)
+        return false;
+    std::string line;
+    int width = 0, height = 0;
+    bool tooBig = false;
+    while (std::getline(in, line))
+    {
+        int n = parseMazeLine(line, nullptr, 0, tooBig);
+        if (n == 0)
+            continue;
+        if (n > width)
+            width = n;
+        height++;
+    }
+    if (width == 0 || tooBig)
+        return false;
+
+    maze.create(width, height);
+    in.clear();
+    in.seekg(0);
+
+    int chunksX = (width + CHUNK_SIZE - 1) >> CHUNK_SHIFT;
+    std::vector<uint8_t> strip((size_t)chunksX * CHUNK_SIZE * CHUNK_SIZE);
+    uint8_t chunk[CHUNK_TILES];
+    int y = 0;
+    while (y < height)
+    {
+        // Pas CHUNK_SIZE rzędów, poza planszą ściana
+        std::memset(strip.data(), TILE_WALL, strip.size());
+        int rows = 0;
+        while (rows < CHUNK_SIZE && y + rows < height && std::getline(in, line))
+        {
+            uint8_t *row = &strip[(size_t)rows * chunksX * CHUNK_SIZE];
+            if (parseMazeLine(line, row, width, tooBig) > 0)
+                rows++;
+        }
+        for (int cx = 0; cx < chunksX; ++cx)
+        {
+            for (int r = 0; r < CHUNK_SIZE; ++r)
+                std::memcpy(chunk + r * CHUNK_SIZE,
+                            &strip[(size_t)r * chunksX * CHUNK_SIZE + cx * CHUNK_SIZE], CHUNK_SIZE);
+            maze.storeChunk(cx, y >> CHUNK_SHIFT, chunk);
+        }
+        y += CHUNK_SIZE;
+    }
+    return true;
+}
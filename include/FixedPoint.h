@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+
+// ----------------- LICZBY STAŁOPRZECINKOWE ---------
+// Pozycje gracza i pantery trzymamy w 1/256 piksela. Ruch jest zawsze wzdłuż
+// jednej osi, więc wystarczą dodawania i porównania - bez sqrt i dzielenia
+// floatów, z tym samym wynikiem na każdym kompilatorze i maszynie.
+
+typedef int32_t fixed_t;
+
+const int FP_SHIFT = 8;
+const fixed_t FP_ONE = 1 << FP_SHIFT; // 1 piksel
+
+// Piksele -> jednostki stałoprzecinkowe
+inline constexpr fixed_t toFixed(int px)
+{
+    return px * FP_ONE;
+}
+
+// Jednostki stałoprzecinkowe -> piksele (zaokrąglenie w dół, pozycje są nieujemne)
+inline constexpr int fixedToInt(fixed_t v)
+{
+    return v >> FP_SHIFT;
+}
+
+// Krok o długości co najwyżej step w stronę d (d = cel - pozycja)
+inline constexpr fixed_t clampStep(fixed_t d, fixed_t step)
+{
+    return d > step ? step : (d < -step ? -step : d);
+}
@@ -0,0 +1,270 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <SDL2/SDL.h>
+
+#include "SpscQueue.h"
+
+// ----------------- NAGRYWANIE ROZGRYWKI ---------
+// Gra kopiuje obraz (SDL_RenderReadPixels) do wolnego bufora z puli i oddaje
+// go wątkowi zapisu przez kolejkę; wątek zapisu koduje klatkę na dysk i oddaje
+// bufor z powrotem. Gdy żaden bufor nie jest wolny (dysk nie nadąża), klatkę
+// pomijamy - pętla gry nigdy nie czeka na zapis.
+// Formaty: *.y4m - surowe YUV 4:2:0 w jednym pliku (ffmpeg/mpv czytają wprost),
+// inaczej sekwencja PPM: <ścieżka>_000000.ppm, <ścieżka>_000001.ppm, ...
+
+const int CAPTURE_POOL_SIZE = 8;
+
+// Co ile sekund wątek zapisu wypisuje statystyki
+const int CAPTURE_REPORT_SECONDS = 5;
+
+class FrameCapture
+{
+public:
+    ~FrameCapture()
+    {
+        stop();
+    }
+
+    bool start(const std::string &outputPath, int frameWidth, int frameHeight, int framesPerSecond)
+    {
+        stop();
+        path = outputPath;
+        width = frameWidth;
+        height = frameHeight;
+        fps = framesPerSecond;
+        y4m = path.size() > 4 && path.compare(path.size() - 4, 4, ".y4m") == 0;
+
+        if (y4m)
+        {
+            file = std::fopen(path.c_str(), "wb");
+            if (!file)
+            {
+                std::cerr << "Cannot open capture file: " << path << std::endl;
+                return false;
+            }
+            std::fprintf(file, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n", width, height, fps);
+        }
+
+        // Cała pamięć przydzielana raz, przy starcie nagrywania
+        for (int i = 0; i < CAPTURE_POOL_SIZE; ++i)
+        {
+            frames[i].assign((size_t)width * height, 0);
+            freeFrames.push(i);
+        }
+        encodeBuffer.assign((size_t)width * height * 3, 0);
+        spareFrame = -1;
+        frameNumber = 0;
+        captured = dropped = written = bytesWritten = grabNanos = 0;
+        startTime = std::chrono::steady_clock::now();
+
+        workerRunning = true;
+        worker = std::thread(&FrameCapture::workerLoop, this);
+        active = true;
+        std::cout << "[CAPTURE] Nagrywanie " << width << "x" << height << " -> " << path << "\n";
+        return true;
+    }
+
+    void stop()
+    {
+        if (!active)
+            return;
+        workerRunning = false;
+        worker.join(); // wątek zapisu najpierw kończy kolejkę
+        if (file)
+        {
+            std::fclose(file);
+            file = nullptr;
+        }
+        int index;
+        while (freeFrames.pop(index))
+        {
+        }
+        active = false;
+        report("koniec");
+    }
+
+    bool isActive() const
+    {
+        return active;
+    }
+
+    // Kopia bieżącego obrazu - wołać po narysowaniu klatki, przed SDL_RenderPresent.
+    // ticks - ile kroków symulacji ta klatka pokazuje (wideo ma stałe tempo,
+    // więc klatka za kilka kroków zapisuje się tyle razy); false, gdy pominięta
+    bool grab(SDL_Renderer *renderer, int ticks = 1)
+    {
+        auto begin = std::chrono::steady_clock::now();
+
+        int outW, outH;
+        SDL_GetRendererOutputSize(renderer, &outW, &outH);
+        int index = spareFrame;
+        if (outW != width || outH != height || (index < 0 && !freeFrames.pop(index)))
+        {
+            dropped++;
+            return false;
+        }
+        spareFrame = -1;
+        if (SDL_RenderReadPixels(renderer, NULL, SDL_PIXELFORMAT_ARGB8888, frames[index].data(), width * 4) != 0)
+        {
+            spareFrame = index; // bufor zostaje u nas (freeFrames wypełnia tylko wątek zapisu)
+            dropped++;
+            return false;
+        }
+        frameIndex[index] = frameNumber;
+        frameRepeat[index] = ticks;
+        frameNumber += ticks;
+        readyFrames.push(index);
+        captured++;
+
+        grabNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         std::chrono::steady_clock::now() - begin)
+                         .count();
+        return true;
+    }
+
+private:
+    void workerLoop()
+    {
+        auto lastReport = std::chrono::steady_clock::now();
+        while (true)
+        {
+            int index;
+            if (readyFrames.pop(index))
+            {
+                if (y4m)
+                    writeY4m(frames[index].data(), frameRepeat[index]);
+                else
+                    for (int r = 0; r < frameRepeat[index]; ++r)
+                        writePpm(frames[index].data(), frameIndex[index] + r);
+                written += frameRepeat[index];
+                freeFrames.push(index);
+
+                auto now = std::chrono::steady_clock::now();
+                if (now - lastReport > std::chrono::seconds(CAPTURE_REPORT_SECONDS))
+                {
+                    report("w toku");
+                    lastReport = now;
+                }
+                continue;
+            }
+            if (!workerRunning)
+                break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+
+    // ARGB -> YUV 4:2:0 (BT.601, zakres ograniczony), chroma ze średniej bloku 2x2
+    void writeY4m(const uint32_t *pixels, int repeat)
+    {
+        int chromaW = (width + 1) / 2, chromaH = (height + 1) / 2;
+        uint8_t *yPlane = encodeBuffer.data();
+        uint8_t *uPlane = yPlane + (size_t)width * height;
+        uint8_t *vPlane = uPlane + (size_t)chromaW * chromaH;
+
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                uint32_t p = pixels[y * width + x];
+                int r = (p >> 16) & 0xFF, g = (p >> 8) & 0xFF, b = p & 0xFF;
+                yPlane[y * width + x] = (uint8_t)(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+            }
+        }
+        for (int cy = 0; cy < chromaH; ++cy)
+        {
+            for (int cx = 0; cx < chromaW; ++cx)
+            {
+                int r = 0, g = 0, b = 0, n = 0;
+                for (int dy = 0; dy < 2; ++dy)
+                    for (int dx = 0; dx < 2; ++dx)
+                    {
+                        int x = cx * 2 + dx, y = cy * 2 + dy;
+                        if (x >= width || y >= height)
+                            continue;
+                        uint32_t p = pixels[y * width + x];
+                        r += (p >> 16) & 0xFF;
+                        g += (p >> 8) & 0xFF;
+                        b += p & 0xFF;
+                        n++;
+                    }
+                r /= n;
+                g /= n;
+                b /= n;
+                uPlane[cy * chromaW + cx] = (uint8_t)(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+                vPlane[cy * chromaW + cx] = (uint8_t)(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+            }
+        }
+
+        size_t frameBytes = (size_t)width * height + 2 * (size_t)chromaW * chromaH;
+        for (int r = 0; r < repeat; ++r)
+        {
+            std::fputs("FRAME\n", file);
+            std::fwrite(encodeBuffer.data(), 1, frameBytes, file);
+            bytesWritten += frameBytes + 6;
+        }
+    }
+
+    void writePpm(const uint32_t *pixels, uint32_t number)
+    {
+        char name[1024];
+        std::snprintf(name, sizeof(name), "%s_%06u.ppm", path.c_str(), (unsigned)number);
+        FILE *out = std::fopen(name, "wb");
+        if (!out)
+        {
+            std::cerr << "Cannot write capture frame: " << name << std::endl;
+            return;
+        }
+        uint8_t *rgb = encodeBuffer.data();
+        for (size_t i = 0; i < (size_t)width * height; ++i)
+        {
+            rgb[i * 3 + 0] = (pixels[i] >> 16) & 0xFF;
+            rgb[i * 3 + 1] = (pixels[i] >> 8) & 0xFF;
+            rgb[i * 3 + 2] = pixels[i] & 0xFF;
+        }
+        std::fprintf(out, "P6\n%d %d\n255\n", width, height);
+        std::fwrite(rgb, 1, (size_t)width * height * 3, out);
+        std::fclose(out);
+        bytesWritten += (size_t)width * height * 3;
+    }
+
+    void report(const char *stage)
+    {
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        uint64_t grabbed = captured;
+        std::cout << "[CAPTURE] (" << stage << ") zapisane: " << written << ", pominiete: " << dropped
+                  << ", " << (seconds > 0 ? written / seconds : 0.0) << " kl/s, "
+                  << (seconds > 0 ? bytesWritten / seconds / (1024.0 * 1024.0) : 0.0) << " MB/s"
+                  << ", kopiowanie w grze: " << (grabbed ? grabNanos / 1e6 / grabbed : 0.0) << " ms/kl\n";
+    }
+
+    // Bufory w formacie ARGB8888, wiersz po wierszu
+    std::vector<uint32_t> frames[CAPTURE_POOL_SIZE];
+    uint32_t frameIndex[CAPTURE_POOL_SIZE] = {};
+    int frameRepeat[CAPTURE_POOL_SIZE] = {};
+    SpscQueue<int, 16> freeFrames;  // wątek zapisu -> gra
+    SpscQueue<int, 16> readyFrames; // gra -> wątek zapisu
+    int spareFrame = -1;
+
+    std::thread worker;
+    std::atomic<bool> workerRunning{false};
+    bool active = false;
+
+    std::string path;
+    bool y4m = true;
+    FILE *file = nullptr;
+    int width = 0, height = 0, fps = 60;
+    uint32_t frameNumber = 0;
+    std::vector<uint8_t> encodeBuffer;
+
+    std::atomic<uint64_t> captured{0}, dropped{0}, written{0}, bytesWritten{0}, grabNanos{0};
+    std::chrono::steady_clock::time_point startTime;
+};
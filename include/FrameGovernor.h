@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+
+// ----------------- REGULATOR KLATEK ---------
+// Pilnuje, żeby praca pętli renderowania (rysowanie i nagrywanie, bez
+// SDL_RenderPresent, który może czekać na vsync) mieściła się w budżecie
+// jednego kroku symulacji. Symulacja ma własny wątek
+// i nadrabia spóźnione kroki, więc tempo gry się nie zmienia - regulator
+// tylko zmniejsza koszt klatki, kiedy host jest przeciążony, i przywraca
+// pełną jakość, gdy obciążenie spadnie.
+//
+// Poziomy są kolejno coraz tańsze; każdy zawiera oszczędności poprzednich.
+// W górę idziemy szybko (GOVERNOR_UP_FRAMES klatek ponad budżetem), w dół
+// powoli (GOVERNOR_DOWN_FRAMES klatek wyraźnie poniżej) - bez migotania
+// między poziomami, gdy czas klatki jest blisko granicy.
+
+enum RenderTier
+{
+    RENDER_TIER_FULL,      // wszystko, co klatkę
+    RENDER_TIER_NO_HUD,    // napis z punktami odświeżany co GOVERNOR_HUD_TICKS
+    RENDER_TIER_CACHED,    // plansza z tekstury (BoardCache), bez nakładki ciepła
+    RENDER_TIER_HALF_RATE, // present co drugi krok symulacji
+    RENDER_TIER_COUNT
+};
+
+static const char *const RENDER_TIER_NAMES[RENDER_TIER_COUNT] = {
+    "pelna jakosc", "HUD rzadziej", "plansza z cache", "pol klatek"};
+
+const int GOVERNOR_UP_FRAMES = 10;
+const int GOVERNOR_DOWN_FRAMES = 120;
+
+// Próg w górę: średnia > 90% budżetu; w dół: średnia < 50% budżetu
+const int GOVERNOR_UP_PERCENT = 90;
+const int GOVERNOR_DOWN_PERCENT = 50;
+
+// Co ile kroków odświeżamy napis z punktami od RENDER_TIER_NO_HUD
+const int GOVERNOR_HUD_TICKS = 30;
+
+class FrameGovernor
+{
+public:
+    explicit FrameGovernor(uint64_t frameBudgetUs)
+        : budgetUs(frameBudgetUs)
+    {
+    }
+
+    // Stały poziom (--tier N, testy); -1 - regulacja automatyczna
+    void force(int forcedTier)
+    {
+        forced = forcedTier;
+        if (forced >= 0 && forced < RENDER_TIER_COUNT)
+            current = (RenderTier)forced;
+    }
+
+    // Po każdej pokazanej klatce: czas pracy w us; true, gdy poziom się zmienił
+    bool frame(uint64_t workUs)
+    {
+        // Średnia wykładnicza z wagą 1/8 (w us * 8, bez ułamków)
+        averageX8 = averageX8 - averageX8 / 8 + workUs;
+        if (forced >= 0)
+            return false;
+
+        uint64_t average = averageX8 / 8;
+        if (average * 100 > budgetUs * GOVERNOR_UP_PERCENT)
+        {
+            underFrames = 0;
+            if (++overFrames >= GOVERNOR_UP_FRAMES && current + 1 < RENDER_TIER_COUNT)
+            {
+                current = (RenderTier)(current + 1);
+                overFrames = 0;
+                return true;
+            }
+        }
+        else if (average * 100 < budgetUs * GOVERNOR_DOWN_PERCENT)
+        {
+            overFrames = 0;
+            if (++underFrames >= GOVERNOR_DOWN_FRAMES && current > RENDER_TIER_FULL)
+            {
+                current = (RenderTier)(current - 1);
+                underFrames = 0;
+                return true;
+            }
+        }
+        else
+        {
+            overFrames = 0;
+            underFrames = 0;
+        }
+        return false;
+    }
+
+    RenderTier tier() const { return current; }
+    uint64_t averageUs() const { return averageX8 / 8; }
+
+private:
+    uint64_t budgetUs;
+    uint64_t averageX8 = 0;
+    int overFrames = 0;
+    int underFrames = 0;
+    int forced = -1;
+    RenderTier current = RENDER_TIER_FULL;
+};
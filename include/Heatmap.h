@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// ----------------- MAPA CIEPŁA KAFELKÓW ---------
+// Liczniki na kafelek: gdzie gracz i pantery spędzają czas, gdzie pantera
+// łapie gracza, gdzie zbierane i oddawane jest złoto. Jedna mapa na wątek
+// (bez atomików - zapis w pętli symulacji to zwykłe ++), scalane merge()
+// po zakończeniu przebiegów.
+
+enum HeatLayer
+{
+    HEAT_VISITS,         // kroki symulacji gracza na kafelku
+    HEAT_PANTHER_VISITS, // kroki symulacji pantery na kafelku
+    HEAT_PANTHER_HITS,   // "Złapała Cię pantera"
+    HEAT_GOLD_PICKUPS,
+    HEAT_DELIVERIES,
+    HEAT_LAYER_COUNT
+};
+
+static const char *const HEAT_LAYER_NAMES[HEAT_LAYER_COUNT] = {
+    "gracz", "pantera", "zlapania", "zloto", "oddane"};
+
+struct TileHeatmap
+{
+    int width = 0, height = 0;
+    uint32_t runs = 0;   // ile przebiegów zsumowano
+    uint64_t ticks = 0;  // ile kroków symulacji łącznie
+    std::vector<uint32_t> counts; // [warstwa][y * width + x]
+
+    void reset(int w, int h)
+    {
+        width = w;
+        height = h;
+        runs = 0;
+        ticks = 0;
+        counts.assign((size_t)HEAT_LAYER_COUNT * w * h, 0);
+    }
+
+    void add(int layer, int x, int y)
+    {
+        if (x >= 0 && y >= 0 && x < width && y < height)
+            counts[((size_t)layer * height + y) * width + x]++;
+    }
+
+    uint32_t get(int layer, int x, int y) const
+    {
+        return counts[((size_t)layer * height + y) * width + x];
+    }
+
+    uint32_t maxOf(int layer) const
+    {
+        uint32_t best = 0;
+        for (int i = 0; i < width * height; ++i)
+            if (counts[(size_t)layer * width * height + i] > best)
+                best = counts[(size_t)layer * width * height + i];
+        return best;
+    }
+
+    // false, gdy wymiary się nie zgadzają (inna plansza)
+    bool merge(const TileHeatmap &other)
+    {
+        if (other.width != width || other.height != height)
+            return false;
+        for (size_t i = 0; i < counts.size(); ++i)
+        {
+            uint64_t sum = (uint64_t)counts[i] + other.counts[i];
+            counts[i] = sum > 0xFFFFFFFFu ? 0xFFFFFFFFu : (uint32_t)sum;
+        }
+        runs += other.runs;
+        ticks += other.ticks;
+        return true;
+    }
+};
+
+// ----------------- PLIK .heat ---------
+// "RFKH", wersja, szerokość, wysokość, liczba warstw (uint16), przebiegi (uint32),
+// kroki (uint64), potem warstwy po kolei jako uint32; wszystko little-endian.
+
+const uint16_t HEATMAP_FILE_VERSION = 1;
+
+inline void writeLe(FILE *f, uint64_t value, int bytes)
+{
+    for (int i = 0; i < bytes; ++i)
+        std::fputc((int)((value >> (8 * i)) & 0xFF), f);
+}
+
+inline bool readLe(FILE *f, uint64_t &value, int bytes)
+{
+    value = 0;
+    for (int i = 0; i < bytes; ++i)
+    {
+        int c = std::fgetc(f);
+        if (c == EOF)
+            return false;
+        value |= (uint64_t)c << (8 * i);
+    }
+    return true;
+}
+
+inline bool saveHeatmap(const std::string &path, const TileHeatmap &heat)
+{
+    FILE *f = std::fopen(path.c_str(), "wb");
+    if (!f)
+        return false;
+    std::fwrite("RFKH", 1, 4, f);
+    writeLe(f, HEATMAP_FILE_VERSION, 2);
+    writeLe(f, heat.width, 2);
+    writeLe(f, heat.height, 2);
+    writeLe(f, HEAT_LAYER_COUNT, 2);
+    writeLe(f, heat.runs, 4);
+    writeLe(f, heat.ticks, 8);
+    for (size_t i = 0; i < heat.counts.size(); ++i)
+        writeLe(f, heat.counts[i], 4);
+    bool ok = !std::ferror(f);
+    std::fclose(f);
+    return ok;
+}
+
+inline bool loadHeatmap(const std::string &path, TileHeatmap &heat)
+{
+    FILE *f = std::fopen(path.c_str(), "rb");
+    if (!f)
+        return false;
+    char magic[4];
+    uint64_t version, w, h, layers, runs, ticks;
+    bool ok = std::fread(magic, 1, 4, f) == 4 && std::string(magic, 4) == "RFKH" &&
+              readLe(f, version, 2) && version == HEATMAP_FILE_VERSION &&
+              readLe(f, w, 2) && readLe(f, h, 2) &&
+              readLe(f, layers, 2) && layers == HEAT_LAYER_COUNT &&
+              readLe(f, runs, 4) && readLe(f, ticks, 8);
+    if (ok)
+    {
+        heat.reset((int)w, (int)h);
+        heat.runs = (uint32_t)runs;
+        heat.ticks = ticks;
+        for (size_t i = 0; ok && i < heat.counts.size(); ++i)
+        {
+            uint64_t v;
+            ok = readLe(f, v, 4);
+            heat.counts[i] = (uint32_t)v;
+        }
+    }
+    std::fclose(f);
+    return ok;
+}
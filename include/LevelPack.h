@@ -0,0 +1,322 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Maze.h"
+#include "Tiles.h"
+
+// ----------------- PACZKA PLANSZ ---------
+// Jeden plik z wieloma planszami: nagłówek, indeks (położenie, rozmiar,
+// suma kontrolna, wymiary, złoto, trudność, nazwa) i spakowane kafelki
+// każdej planszy. Plik jest mapowany (mmap) - otwarcie czyta tylko nagłówek
+// i indeks, więc wybór poziomu i start gry nie dotykają danych plansz.
+// Plansza jest rozpakowywana dopiero przy level(n) i trzymana w małym
+// cache LRU (powrót do ostatnio granych plansz nic nie kosztuje).
+//
+// Kafelki są spakowane RLE po bajcie na serię: 4 bity wartość kafelka
+// (0..15, jak w ChunkedMaze), 4 bity długość serii - 1 (1..16). Ściany
+// i korytarze idą seriami, więc plansza 22x24 to ~250 bajtów zamiast 528.
+// Liczby w pliku są w kolejności bajtów maszyny (paczki budujemy i czytamy
+// na tej samej architekturze).
+//
+// Budowanie paczki: narzędzie level_pack.
+
+const uint32_t LEVEL_PACK_MAGIC = 0x50464B52; // "RKFP"
+const uint32_t LEVEL_PACK_VERSION = 1;
+const int LEVEL_PACK_NAME_SIZE = 32;
+
+// Rozpakowane plansze w pamięci
+const int LEVEL_PACK_CACHE_SLOTS = 8;
+
+// Trudność 1..5: co tyle ruchów planu solvera o stopień wyżej
+const int LEVEL_PACK_MOVES_PER_DIFFICULTY = 100;
+
+struct LevelPackHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t levelCount;
+    uint32_t entrySize; // sizeof(LevelPackEntry) - czytelnik sprawdza układ
+};
+
+struct LevelPackEntry
+{
+    uint32_t offset;      // od początku pliku
+    uint32_t packedBytes; // długość danych RLE
+    uint32_t checksum;    // FNV-1a danych RLE
+    uint16_t width, height;
+    uint16_t goldUnits;   // sztuki złota (3 liczy się podwójnie)
+    uint16_t solverMoves; // ruchy planu solvera (0 - nie do przejścia)
+    uint8_t difficulty;   // 1..5, 0 - nie do przejścia
+    uint8_t reserved[3];
+    char name[LEVEL_PACK_NAME_SIZE];
+};
+
+static_assert(std::is_trivially_copyable<LevelPackEntry>::value, "indeks czytamy wprost z pliku");
+static_assert(sizeof(LevelPackEntry) == 56, "uklad indeksu paczki");
+
+inline uint32_t levelPackChecksum(const uint8_t *data, size_t bytes)
+{
+    uint32_t hash = 0x811C9DC5u;
+    for (size_t i = 0; i < bytes; ++i)
+    {
+        hash ^= data[i];
+        hash *= 0x01000193u;
+    }
+    return hash;
+}
+
+inline uint8_t levelPackDifficulty(int solverMoves)
+{
+    if (solverMoves <= 0)
+        return 0;
+    int d = 1 + solverMoves / LEVEL_PACK_MOVES_PER_DIFFICULTY;
+    return (uint8_t)(d > 5 ? 5 : d);
+}
+
+// count kafelków (wartości 0..15) -> serie RLE dopisane do out
+inline void packLevelTiles(const uint8_t *tiles, int count, std::vector<uint8_t> &out)
+{
+    int i = 0;
+    while (i < count)
+    {
+        uint8_t value = tiles[i] & 0x0F;
+        int run = 1;
+        while (run < 16 && i + run < count && tiles[i + run] == value)
+            run++;
+        out.push_back((uint8_t)((value << 4) | (run - 1)));
+        i += run;
+    }
+}
+
+// false, gdy dane nie dają dokładnie count kafelków
+inline bool unpackLevelTiles(const uint8_t *src, size_t bytes, uint8_t *tiles, int count)
+{
+    int n = 0;
+    for (size_t i = 0; i < bytes; ++i)
+    {
+        int run = (src[i] & 0x0F) + 1;
+        if (n + run > count)
+            return false;
+        std::memset(tiles + n, src[i] >> 4, run);
+        n += run;
+    }
+    return n == count;
+}
+
+class LevelPack
+{
+public:
+    ~LevelPack()
+    {
+        close();
+    }
+
+    // Mapuje plik i sprawdza nagłówek oraz indeks (bez czytania plansz)
+    bool open(const char *path)
+    {
+        close();
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0)
+        {
+            std::cerr << "Cannot open level pack: " << path << std::endl;
+            return false;
+        }
+        struct stat info;
+        void *mem = MAP_FAILED;
+        if (fstat(fd, &info) == 0 && (size_t)info.st_size >= sizeof(LevelPackHeader))
+            mem = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mem == MAP_FAILED)
+        {
+            std::cerr << "Cannot map level pack: " << path << std::endl;
+            return false;
+        }
+        data = static_cast<const uint8_t *>(mem);
+        bytes = (size_t)info.st_size;
+
+        const LevelPackHeader *header = reinterpret_cast<const LevelPackHeader *>(data);
+        if (header->magic != LEVEL_PACK_MAGIC || header->version != LEVEL_PACK_VERSION ||
+            header->entrySize != sizeof(LevelPackEntry) ||
+            sizeof(LevelPackHeader) + (size_t)header->levelCount * sizeof(LevelPackEntry) > bytes)
+        {
+            std::cerr << "Invalid level pack header: " << path << std::endl;
+            close();
+            return false;
+        }
+        entries = reinterpret_cast<const LevelPackEntry *>(data + sizeof(LevelPackHeader));
+        count = (int)header->levelCount;
+        for (int i = 0; i < count; ++i)
+        {
+            const LevelPackEntry &e = entries[i];
+            // Iloczyn bez znaku - dwa uint16_t jako int przepełniają się dla dużych wymiarów
+            if ((size_t)e.offset + e.packedBytes > bytes || e.width == 0 || e.height == 0 ||
+                (uint32_t)e.width * e.height > 0xFFFF)
+            {
+                std::cerr << "Invalid level pack entry " << i << ": " << path << std::endl;
+                close();
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void close()
+    {
+        if (data)
+            munmap(const_cast<uint8_t *>(data), bytes);
+        data = nullptr;
+        bytes = 0;
+        entries = nullptr;
+        count = 0;
+        for (int i = 0; i < LEVEL_PACK_CACHE_SLOTS; ++i)
+            slots[i].index = -1;
+    }
+
+    int size() const { return count; }
+    const LevelPackEntry &entry(int index) const { return entries[index]; }
+
+    // Rozpakowana plansza; wskaźnik ważny, dopóki LEVEL_PACK_CACHE_SLOTS innych
+    // plansz nie wypchnie jej z cache (kto gra dłużej, robi kopię).
+    // nullptr dla złego numeru albo uszkodzonych danych.
+    const TileGrid *level(int index)
+    {
+        if (index < 0 || index >= count)
+            return nullptr;
+        int victim = 0;
+        for (int i = 0; i < LEVEL_PACK_CACHE_SLOTS; ++i)
+        {
+            if (slots[i].index == index)
+            {
+                hits++;
+                slots[i].lastUse = ++useClock;
+                return &slots[i].grid;
+            }
+            if (slots[i].lastUse < slots[victim].lastUse)
+                victim = i;
+        }
+
+        misses++;
+        const LevelPackEntry &e = entries[index];
+        const uint8_t *src = data + e.offset;
+        Slot &s = slots[victim];
+        s.index = -1;
+        if (levelPackChecksum(src, e.packedBytes) != e.checksum)
+        {
+            std::cerr << "Level pack checksum mismatch: level " << index << std::endl;
+            return nullptr;
+        }
+        int cells = (int)((uint32_t)e.width * e.height); // <= 0xFFFF, sprawdzone w open()
+        s.tiles.resize(cells);
+        if (!unpackLevelTiles(src, e.packedBytes, s.tiles.data(), cells))
+        {
+            std::cerr << "Level pack data corrupt: level " << index << std::endl;
+            return nullptr;
+        }
+        s.grid.width = e.width;
+        s.grid.height = e.height;
+        s.grid.tiles = s.tiles.data();
+        s.index = index;
+        s.lastUse = ++useClock;
+        return &s.grid;
+    }
+
+    uint64_t cacheHits() const { return hits; }
+    uint64_t cacheMisses() const { return misses; }
+
+private:
+    struct Slot
+    {
+        int index = -1;
+        uint32_t lastUse = 0;
+        std::vector<uint8_t> tiles;
+        TileGrid grid;
+    };
+
+    const uint8_t *data = nullptr;
+    size_t bytes = 0;
+    const LevelPackEntry *entries = nullptr;
+    int count = 0;
+
+    Slot slots[LEVEL_PACK_CACHE_SLOTS];
+    uint32_t useClock = 0;
+    uint64_t hits = 0, misses = 0;
+};
+
+// Budowanie paczki: add() pakuje planszę od razu, write() zapisuje całość
+class LevelPackWriter
+{
+public:
+    // Krótsze rzędy dopełniamy ścianami (jak initGameState); false dla
+    // wartości > 15 albo planszy większej niż 0xFFFF pól
+    bool add(const std::string &name, const Maze &maze, int goldUnits, int solverMoves)
+    {
+        for (int y = 0; y < mazeHeight(maze); ++y)
+            for (int x = 0; x < mazeRowWidth(maze, y); ++x)
+                if (tileAt(maze, x, y) < 0 || tileAt(maze, x, y) > 15)
+                    return false;
+        std::vector<uint8_t> tiles;
+        TileGrid grid = flattenMaze(maze, tiles);
+        if (grid.width == 0 || grid.width * grid.height > 0xFFFF)
+            return false;
+
+        LevelPackEntry e;
+        std::memset(&e, 0, sizeof(e));
+        e.offset = (uint32_t)payload.size(); // względem danych; write() dodaje początek
+        packLevelTiles(tiles.data(), (int)tiles.size(), payload);
+        e.packedBytes = (uint32_t)(payload.size() - e.offset);
+        e.checksum = levelPackChecksum(&payload[e.offset], e.packedBytes);
+        e.width = (uint16_t)grid.width;
+        e.height = (uint16_t)grid.height;
+        e.goldUnits = (uint16_t)goldUnits;
+        e.solverMoves = (uint16_t)(solverMoves > 0xFFFF ? 0xFFFF : solverMoves);
+        e.difficulty = levelPackDifficulty(solverMoves);
+        std::strncpy(e.name, name.c_str(), LEVEL_PACK_NAME_SIZE - 1);
+        entries.push_back(e);
+        return true;
+    }
+
+    int size() const { return (int)entries.size(); }
+    size_t payloadBytes() const { return payload.size(); }
+
+    bool write(const char *path) const
+    {
+        FILE *file = std::fopen(path, "wb");
+        if (!file)
+        {
+            std::cerr << "Cannot write level pack: " << path << std::endl;
+            return false;
+        }
+        LevelPackHeader header = {LEVEL_PACK_MAGIC, LEVEL_PACK_VERSION, (uint32_t)entries.size(),
+                                  (uint32_t)sizeof(LevelPackEntry)};
+        uint32_t start = (uint32_t)(sizeof(header) + entries.size() * sizeof(LevelPackEntry));
+        std::vector<LevelPackEntry> index(entries);
+        for (size_t i = 0; i < index.size(); ++i)
+            index[i].offset += start;
+
+        bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+        if (!index.empty())
+            ok = ok && std::fwrite(index.data(), sizeof(LevelPackEntry), index.size(), file) == index.size();
+        if (!payload.empty())
+            ok = ok && std::fwrite(payload.data(), 1, payload.size(), file) == payload.size();
+        ok = std::fclose(file) == 0 && ok;
+        if (!ok)
+            std::cerr << "Cannot write level pack: " << path << std::endl;
+        return ok;
+    }
+
+private:
+    std::vector<LevelPackEntry> entries;
+    std::vector<uint8_t> payload;
+};
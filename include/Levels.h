@@ -0,0 +1,235 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+#include "Maze.h"
+#include "Simulation.h"
+#include "Tiles.h"
+
+// ----------------- WBUDOWANE PLANSZE ---------
+// Plansze są tablicami constexpr w pliku wykonywalnym (zero pracy przy starcie)
+// i są sprawdzane static_assertem w czasie kompilacji: równe rzędy, otwarte
+// pole startowe i skarbiec, złoto osiągalne ze startu, pantera nie w ścianie.
+// Pliki maze1.txt / mazeGen.txt są dołączane wprost przez #include - mają
+// już format "{1,0,...}," (jeden rząd w linii).
+
+const int LEVEL_MAX_WIDTH = 32;
+const int LEVEL_MAX_HEIGHT = 32;
+
+// Jeden rząd zapisany jako "{1, 0, ...}"; szerokość liczymy, żeby wykryć
+// rzędy różnej długości (zwykła tablica int[][22] dopełniłaby je zerami)
+struct LevelRow
+{
+    uint8_t cells[LEVEL_MAX_WIDTH] = {};
+    int width = 0;
+    bool badValue = false;
+
+    constexpr LevelRow(std::initializer_list<int> values)
+    {
+        for (int v : values)
+        {
+            if (v < 0 || v > 255)
+                badValue = true;
+            if (width < LEVEL_MAX_WIDTH)
+                cells[width] = (uint8_t)v;
+            width++;
+        }
+    }
+};
+
+struct Level
+{
+    const char *name;
+    const LevelRow *rows;
+    int width, height;
+};
+
+template <size_t H>
+constexpr Level makeLevel(const char *name, const LevelRow (&rows)[H])
+{
+    return Level{name, rows, rows[0].width, (int)H};
+}
+
+// Dostęp jak do Maze/TileGrid (dla computeTargetCell, initGameState)
+inline int mazeHeight(const Level &level) { return level.height; }
+inline int mazeRowWidth(const Level &level, int y) { return level.rows[y].width; }
+inline int tileAt(const Level &level, int x, int y) { return level.rows[y].cells[x]; }
+
+// ----------------- SPRAWDZANIE W CZASIE KOMPILACJI ---------
+
+constexpr bool levelRowsValid(const Level &level)
+{
+    if (level.height < 3 || level.height > LEVEL_MAX_HEIGHT)
+        return false;
+    if (level.width < 3 || level.width > LEVEL_MAX_WIDTH)
+        return false;
+    for (int y = 0; y < level.height; ++y)
+        if (level.rows[y].width != level.width || level.rows[y].badValue)
+            return false;
+    return true;
+}
+
+constexpr bool levelCellOpen(const Level &level, int x, int y)
+{
+    return x >= 0 && y >= 0 && x < level.width && y < level.height &&
+           !TILE_TABLE.info[level.rows[y].cells[x]].solid;
+}
+
+constexpr bool levelStartOpen(const Level &level)
+{
+    return levelCellOpen(level, START_CELL_X, START_CELL_Y) &&
+           levelCellOpen(level, VAULT_CELL_X, VAULT_CELL_Y);
+}
+
+// Całe złoto osiągalne ze startu (flood fill po otwartych polach)
+constexpr bool levelGoldReachable(const Level &level)
+{
+    bool seen[LEVEL_MAX_WIDTH * LEVEL_MAX_HEIGHT] = {};
+    int stack[LEVEL_MAX_WIDTH * LEVEL_MAX_HEIGHT] = {};
+    int top = 0;
+    stack[top++] = START_CELL_Y * level.width + START_CELL_X;
+    seen[stack[0]] = true;
+    while (top > 0)
+    {
+        int cell = stack[--top];
+        int x = cell % level.width, y = cell / level.width;
+        const int dx[4] = {1, -1, 0, 0};
+        const int dy[4] = {0, 0, 1, -1};
+        for (int d = 0; d < 4; ++d)
+        {
+            int nx = x + dx[d], ny = y + dy[d];
+            if (levelCellOpen(level, nx, ny) && !seen[ny * level.width + nx])
+            {
+                seen[ny * level.width + nx] = true;
+                stack[top++] = ny * level.width + nx;
+            }
+        }
+    }
+    for (int y = 0; y < level.height; ++y)
+        for (int x = 0; x < level.width; ++x)
+            if (TILE_TABLE.info[level.rows[y].cells[x]].gold && !seen[y * level.width + x])
+                return false;
+    return true;
+}
+
+constexpr bool levelPantherSpawnOpen(const Level &level)
+{
+    return levelCellOpen(level, PANTHER_START_CELL_X, PANTHER_START_CELL_Y);
+}
+
+// Wszystkie sprawdzenia naraz, z nazwą planszy w komunikacie błędu
+#define STATIC_CHECK_LEVEL(level)                                                          \
+    static_assert(levelRowsValid(level), #level ": zly rozmiar albo rzedy roznej dlugosci"); \
+    static_assert(levelStartOpen(level), #level ": zamkniety start albo skarbiec");          \
+    static_assert(levelGoldReachable(level), #level ": zloto nieosiagalne ze startu");        \
+    static_assert(levelPantherSpawnOpen(level), #level ": pantera startuje w scianie")
+
+// ----------------- PLANSZE ---------
+
+// Labirynt 1 (1=ściana, 0=ścieżka, 5=życie, 4 - złoto, 3 - złoto podwójne)
+constexpr LevelRow LEVEL1_ROWS[] = {
+    {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 1, 1},
+    {1, 3, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 1},
+    {1, 0, 1, 0, 1, 1, 1, 1, 1, 0, 1, 1, 1, 0, 1, 0, 1, 1, 1, 0, 1, 1},
+    {1, 0, 1, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 1},
+    {1, 0, 1, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 1, 1, 1, 1, 0, 1, 0, 1, 1},
+    {1, 0, 1, 0, 1, 0, 1, 0, 0, 0, 1, 0, 1, 0, 0, 0, 0, 0, 1, 0, 1, 1},
+    {1, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0, 1, 1, 1, 1, 1, 0, 1, 1},
+    {1, 0, 0, 0, 1, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 1},
+    {1, 0, 1, 1, 1, 0, 1, 1, 0, 1, 1, 1, 1, 1, 1, 0, 1, 0, 1, 1, 1, 1},
+    {1, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 1},
+    {1, 0, 1, 0, 1, 1, 1, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 1, 1},
+    {1, 4, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 4, 1, 0, 0, 0, 1, 0, 1, 1},
+    {1, 1, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 1, 1, 0, 1, 0, 1, 0, 1, 1},
+    {1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 1},
+    {1, 0, 1, 1, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1},
+    {1, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 1},
+    {1, 0, 1, 0, 1, 1, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 0, 1, 1},
+    {1, 0, 0, 0, 1, 0, 1, 0, 0, 0, 1, 3, 0, 0, 1, 0, 0, 0, 1, 0, 1, 1},
+    {1, 0, 1, 1, 1, 0, 1, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 1, 1},
+    {1, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 1, 1},
+    {1, 0, 1, 1, 1, 0, 1, 1, 1, 1, 1, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 1},
+    {1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 1},
+    {1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 1},
+    {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1},
+};
+
+constexpr LevelRow MAZE1_ROWS[] = {
+#include "../maze1.txt"
+};
+
+constexpr LevelRow MAZE_GEN_ROWS[] = {
+#include "../mazeGen.txt"
+};
+
+constexpr Level BUILTIN_LEVELS[] = {
+    makeLevel("labirynt 1", LEVEL1_ROWS),
+    makeLevel("maze1.txt", MAZE1_ROWS),
+    makeLevel("mazeGen.txt", MAZE_GEN_ROWS),
+};
+
+const int BUILTIN_LEVEL_COUNT = (int)(sizeof(BUILTIN_LEVELS) / sizeof(BUILTIN_LEVELS[0]));
+
+STATIC_CHECK_LEVEL(BUILTIN_LEVELS[0]);
+STATIC_CHECK_LEVEL(BUILTIN_LEVELS[1]);
+STATIC_CHECK_LEVEL(BUILTIN_LEVELS[2]);
+
+// Szablony (górny rząd z życiami 5,5,5 - nie są grywalne: w maze2 pantera
+// startowałaby w ścianie, szablon ma 23 rzędy); sprawdzamy tylko rzędy
+constexpr LevelRow LEVEL2_TEMPLATE_ROWS[] = {
+    {5, 5, 5, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 1, 1},
+    {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 1, 1},
+    {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 1, 1},
+    {1, 0, 0, 0, 0, 0, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1},
+    {1, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 1, 1, 1, 1, 1, 1, 1, 0, 1, 0, 1},
+    {1, 0, 1, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 1},
+    {1, 0, 1, 0, 1, 1, 1, 0, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 0, 1},
+    {1, 0, 1, 0, 1, 1, 1, 0, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 0, 1},
+    {1, 0, 1, 0, 0, 0, 0, 0, 0, 1, 0, 1, 1, 1, 0, 1, 1, 0, 0, 1, 0, 1},
+    {1, 0, 1, 1, 1, 1, 1, 1, 0, 1, 0, 0, 0, 1, 0, 1, 0, 0, 1, 1, 0, 1},
+    {1, 0, 0, 0, 0, 4, 3, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0, 1, 1, 0, 0, 1},
+    {1, 0, 0, 1, 1, 1, 1, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0, 1, 1, 0, 1, 1},
+    {1, 0, 0, 0, 0, 4, 3, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0, 1, 1, 0, 0, 1},
+    {1, 0, 0, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1, 1, 0, 1},
+    {1, 0, 0, 0, 0, 4, 3, 1, 0, 1, 0, 1, 1, 0, 1, 1, 1, 0, 0, 0, 0, 1},
+    {1, 0, 1, 1, 1, 1, 1, 1, 0, 1, 0, 1, 1, 0, 1, 1, 1, 0, 1, 1, 0, 1},
+    {1, 0, 0, 0, 0, 0, 1, 1, 0, 1, 0, 1, 1, 0, 1, 1, 1, 0, 1, 1, 0, 1},
+    {1, 1, 0, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 0, 1},
+    {1, 1, 0, 1, 1, 0, 1, 1, 0, 1, 1, 0, 1, 0, 1, 1, 1, 1, 1, 1, 0, 1},
+    {1, 1, 0, 1, 1, 0, 1, 1, 0, 1, 1, 0, 1, 0, 0, 0, 0, 0, 1, 1, 0, 1},
+    {1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 0, 0, 0, 0, 1},
+    {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1},
+    {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1},
+    {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1},
+};
+
+constexpr LevelRow EMPTY_TEMPLATE_ROWS[] = {
+    {5, 5, 5, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 1, 1},
+    {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 1, 1},
+    {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 1, 1},
+    {1, 0, 0, 0, 0, 0, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1},
+    {1, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 1, 1, 1, 1, 1, 1, 1, 0, 1, 0, 1},
+    {1, 0, 1, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 1},
+    {1, 0, 1, 0, 1, 1, 1, 0, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 0, 1},
+    {1, 0, 1, 0, 1, 1, 1, 0, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 0, 1},
+    {1, 0, 1, 0, 0, 0, 0, 0, 0, 1, 0, 1, 1, 1, 0, 1, 1, 0, 0, 1, 0, 1},
+    {1, 0, 1, 1, 1, 1, 1, 1, 0, 1, 0, 0, 0, 1, 0, 1, 0, 0, 1, 1, 0, 1},
+    {1, 0, 0, 0, 0, 4, 3, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0, 1, 1, 0, 0, 1},
+    {1, 0, 0, 1, 1, 1, 1, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0, 1, 1, 0, 1, 1},
+    {1, 0, 0, 0, 0, 4, 3, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0, 1, 1, 0, 0, 1},
+    {1, 0, 0, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1, 1, 0, 1},
+    {1, 0, 0, 0, 0, 4, 3, 1, 0, 1, 0, 1, 1, 0, 1, 1, 1, 0, 0, 0, 0, 1},
+    {1, 0, 1, 1, 1, 1, 1, 1, 0, 1, 0, 1, 1, 0, 1, 1, 1, 0, 1, 1, 0, 1},
+    {1, 0, 0, 0, 0, 0, 1, 1, 0, 1, 0, 1, 1, 0, 1, 1, 1, 0, 1, 1, 0, 1},
+    {1, 1, 0, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 0, 1},
+    {1, 1, 0, 1, 1, 0, 1, 1, 0, 1, 1, 0, 1, 0, 1, 1, 1, 1, 1, 1, 0, 1},
+    {1, 1, 0, 1, 1, 0, 1, 1, 0, 1, 1, 0, 1, 0, 0, 0, 0, 0, 1, 1, 0, 1},
+    {1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 0, 0, 0, 0, 1},
+    {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1},
+    {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1},
+};
+
+static_assert(levelRowsValid(makeLevel("maze2", LEVEL2_TEMPLATE_ROWS)), "maze2: rzedy roznej dlugosci");
+static_assert(levelRowsValid(makeLevel("szablon", EMPTY_TEMPLATE_ROWS)), "szablon: rzedy roznej dlugosci");
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "Tiles.h"
+
+// ----------------- LABIRYNT: wspólne definicje ---------
+// Używane zarówno przez grę, jak i przez narzędzia (solver, generator).
+
+// Wartości kafelków (1=ściana, 0=ścieżka, 5=życie, 4 - złoto, 3 - złoto podwójne)
+typedef std::vector<std::vector<int>> Maze;
+
+// Płaska plansza w pamięci z zewnątrz (w grze: arena poziomu, patrz Arena.h)
+struct TileGrid
+{
+    int width = 0, height = 0;
+    uint8_t *tiles = nullptr;
+
+    uint8_t &at(int x, int y) { return tiles[y * width + x]; }
+    uint8_t at(int x, int y) const { return tiles[y * width + x]; }
+};
+
+// Wspólny dostęp do obu reprezentacji (dla funkcji-szablonów poniżej)
+inline int mazeHeight(const Maze &maze) { return (int)maze.size(); }
+inline int mazeRowWidth(const Maze &maze, int y) { return (int)maze[y].size(); }
+inline int tileAt(const Maze &maze, int x, int y) { return maze[y][x]; }
+
+inline int mazeHeight(const TileGrid &grid) { return grid.height; }
+inline int mazeRowWidth(const TileGrid &grid, int) { return grid.width; }
+inline int tileAt(const TileGrid &grid, int x, int y) { return grid.at(x, y); }
+
+// Gracz zaczyna w kafelku (19,1), złoto oddaje się w skarbcu (19,0)
+const int START_CELL_X = 19;
+const int START_CELL_Y = 1;
+const int VAULT_CELL_X = 19;
+const int VAULT_CELL_Y = 0;
+
+// Funkcja do obliczenia, dokąd można dojść w danym kierunku (dx, dy) aż do ściany.
+template <typename Grid>
+inline void computeTargetCell(
+    const Grid &maze,
+    int startCellX, int startCellY,
+    int dx, int dy,
+    int &outX, int &outY)
+{
+    int newX = startCellX;
+    int newY = startCellY;
+
+    while (true)
+    {
+        int testX = newX + dx;
+        int testY = newY + dy;
+
+        if (testY < 0 || testY >= mazeHeight(maze) ||
+            testX < 0 || testX >= mazeRowWidth(maze, testY))
+        {
+            break; // poza tablicą
+        }
+        if (isSolidTile(tileAt(maze, testX, testY)))
+        {
+            break; // ściana
+        }
+        newX = testX;
+        newY = testY;
+    }
+    outX = newX;
+    outY = newY;
+}
+
+// Kopia dowolnej planszy do płaskiej tablicy storage (krótsze rzędy
+// dopełnione ścianą); zwrócony TileGrid wskazuje na storage
+template <typename Grid>
+inline TileGrid flattenMaze(const Grid &maze, std::vector<uint8_t> &storage)
+{
+    TileGrid grid;
+    grid.height = mazeHeight(maze);
+    for (int y = 0; y < grid.height; ++y)
+        if (mazeRowWidth(maze, y) > grid.width)
+            grid.width = mazeRowWidth(maze, y);
+    storage.assign((size_t)grid.width * grid.height, TILE_WALL);
+    for (int y = 0; y < grid.height; ++y)
+        for (int x = 0; x < mazeRowWidth(maze, y); ++x)
+            storage[(size_t)y * grid.width + x] = (uint8_t)tileAt(maze, x, y);
+    grid.tiles = storage.data();
+    return grid;
+}
+
+// Wczytanie planszy w formacie "{1,0,0,...}," (jeden rząd w linii)
+inline bool loadMazeFile(const std::string &path, Maze &maze)
+{
+    std::ifstream in(path.c_str());
+    if (!in)
+        return false;
+    maze.clear();
+    std::string line;
+    while (std::getline(in, line))
+    {
+        std::vector<int> row;
+        for (size_t i = 0; i < line.size(); ++i)
+        {
+            if (line[i] >= '0' && line[i] <= '9')
+            {
+                int v = 0;
+                while (i < line.size() && line[i] >= '0' && line[i] <= '9')
+                    v = v * 10 + (line[i++] - '0');
+                row.push_back(v);
+            }
+        }
+        if (!row.empty())
+            maze.push_back(row);
+    }
+    return !maze.empty();
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <vector>
+
+#include "Maze.h"
+#include "Random.h"
+
+// ----------------- GENERATOR LABIRYNTU (wersja natywna) ---------
+// Ten sam algorytm co w maze_gen.py (DFS po komórkach nieparzystych, stałe dwa
+// dolne rzędy, złoto w ślepych zaułkach), ale bez Pythona - żeby solver mógł
+// generować i sprawdzać tysiące plansz na raz.
+// Różnice: DFS jest iteracyjny (duże labirynty nie przepełnią stosu) oraz
+// otwieramy wejście do skarbca (19,0), bez którego nie da się oddać złota.
+
+inline Maze generateMaze(int width, int height, Rng &rng)
+{
+    // Wymiary nieparzyste + ramka, tak jak w maze_gen.py
+    if (width % 2 == 0)
+        width -= 1;
+    if (height % 2 == 0)
+        height -= 1;
+    width += 1;
+    height += 1;
+
+    Maze maze(height, std::vector<int>(width, 1));
+
+    // DFS ze stosem zamiast rekurencji
+    struct Frame
+    {
+        int y, x;
+        int dirs[4];
+        int next;
+    };
+    static const int DIR_Y[4] = {0, 2, 0, -2};
+    static const int DIR_X[4] = {2, 0, -2, 0};
+
+    auto makeFrame = [&](int y, int x)
+    {
+        Frame f = {y, x, {0, 1, 2, 3}, 0};
+        rng.shuffle(f.dirs, 4);
+        return f;
+    };
+
+    // Start DFS z losowej komórki
+    int startY = 1 + 2 * rng.range(0, (height - 3) / 2);
+    int startX = 1 + 2 * rng.range(0, (width - 3) / 2);
+    maze[startY][startX] = 0;
+
+    std::vector<Frame> stack;
+    stack.push_back(makeFrame(startY, startX));
+    while (!stack.empty())
+    {
+        Frame &f = stack.back();
+        if (f.next == 4)
+        {
+            stack.pop_back();
+            continue;
+        }
+        int d = f.dirs[f.next++];
+        int ny = f.y + DIR_Y[d];
+        int nx = f.x + DIR_X[d];
+        if (ny >= 1 && ny < height - 1 && nx >= 1 && nx < width - 1 && maze[ny][nx] == 1)
+        {
+            // Usuwamy ścianę pomiędzy komórkami
+            maze[f.y + DIR_Y[d] / 2][f.x + DIR_X[d] / 2] = 0;
+            maze[ny][nx] = 0;
+            stack.push_back(makeFrame(ny, nx)); // f może być już nieważne
+        }
+    }
+
+    // Ramka ze ścian
+    for (int i = 0; i < width; ++i)
+        maze[0][i] = maze[height - 1][i] = 1;
+    for (int i = 0; i < height; ++i)
+        maze[i][0] = maze[i][width - 1] = 1;
+
+    // Dolne rzędy bez podwójnych ścian
+    for (int i = 1; i < width - 1; ++i)
+        maze[height - 2][i] = ((i - 1) % 2 == 0) ? 0 : 1;
+    for (int i = 0; i < width; ++i)
+        maze[height - 1][i] = 1;
+
+    auto openNeighbours = [&](int y, int x)
+    {
+        return (maze[y - 1][x] == 0) + (maze[y + 1][x] == 0) +
+               (maze[y][x - 1] == 0) + (maze[y][x + 1] == 0);
+    };
+
+    // Usuwamy odizolowane komórki
+    for (int i = 1; i < height - 1; ++i)
+        for (int j = 1; j < width - 1; ++j)
+            if (maze[i][j] == 0 && openNeighbours(i, j) == 0)
+                maze[i][j] = 1;
+
+    // Wejście do skarbca nad polem startowym
+    if (VAULT_CELL_X < width - 1 && START_CELL_Y < height - 1 &&
+        !isSolidTile(maze[START_CELL_Y][START_CELL_X]))
+    {
+        maze[VAULT_CELL_Y][VAULT_CELL_X] = 0;
+    }
+
+    // Złoto (3 i 4) w ślepych zaułkach, z pominięciem trzech dolnych rzędów
+    for (int i = 1; i < height - 3; i += 2)
+        for (int j = 1; j < width - 1; j += 2)
+            if (maze[i][j] == 0 && openNeighbours(i, j) == 1 && rng.real01() > 0.6)
+                maze[i][j] = rng.coin() ? TILE_GOLD2 : TILE_GOLD;
+
+    return maze;
+}
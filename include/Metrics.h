@@ -0,0 +1,289 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ----------------- METRYKI W PAMIĘCI WSPÓŁDZIELONEJ ---------
+// Liczniki i histogram czasu klatki leżą w segmencie POSIX shm, który
+// zewnętrzny program (metrics_top) czyta na żywo. Gra tylko dodaje do
+// atomików (relaxed) - w pętli gry nie ma żadnego wywołania systemowego.
+// Układ bloku jest stały i wersjonowany: czytelnik sprawdza magic, wersję
+// i rozmiar, zanim cokolwiek odczyta. Nowe pola dopisujemy na końcu
+// i podbijamy METRICS_LAYOUT_VERSION.
+
+const char *const METRICS_SHM_NAME = "/raid_on_fort_knox";
+const uint32_t METRICS_MAGIC = 0x4D4B4652; // "RFKM"
+const uint32_t METRICS_LAYOUT_VERSION = 5;
+
+// Histogram czasu klatki w mikrosekundach: 4 przedziały na każdą potęgę
+// dwójki (błąd < 25%), do ~4 s; ostatni przedział zbiera resztę
+const int METRICS_HIST_BUCKETS = 88;
+
+inline int metricsBucket(uint64_t us)
+{
+    if (us < 4)
+        return (int)us;
+    int e = 63 - __builtin_clzll(us);
+    int bucket = e * 4 + (int)((us >> (e - 2)) & 3);
+    return bucket < METRICS_HIST_BUCKETS ? bucket : METRICS_HIST_BUCKETS - 1;
+}
+
+// Górna granica przedziału (wyłącznie), w mikrosekundach
+inline uint64_t metricsBucketLimit(int bucket)
+{
+    if (bucket < 4)
+        return (uint64_t)bucket + 1;
+    int e = bucket / 4;
+    return (uint64_t)(4 + bucket % 4 + 1) << (e - 2);
+}
+
+typedef std::atomic<uint64_t> MetricCounter;
+static_assert(MetricCounter::is_always_lock_free, "liczniki w shm musza byc bez blokad");
+
+struct MetricsBlock
+{
+    // Nagłówek - magic zapisywany na końcu inicjalizacji
+    std::atomic<uint32_t> magic;
+    uint32_t layoutVersion;
+    uint32_t blockSize;
+    uint32_t pid;
+    uint32_t tickRate; // docelowe kroki symulacji na sekundę
+    uint32_t reserved;
+
+    // Pętla renderowania
+    MetricCounter frames;
+    MetricCounter frameTimeSumUs;
+    MetricCounter frameTimeHist[METRICS_HIST_BUCKETS];
+
+    // Symulacja
+    MetricCounter ticks;
+    MetricCounter deliveries;  // oddane złoto, suma ze wszystkich poziomów
+    MetricCounter goldPickups;
+    MetricCounter pantherHits;
+    MetricCounter restarts;
+    std::atomic<int64_t> score; // punkty w bieżącym poziomie
+
+    // Czas ostatniej aktualizacji (steady_clock, ns) - czytelnik widzi, że gra stoi
+    MetricCounter heartbeatNs;
+
+    // Czas procesora całego procesu (wszystkie wątki), odświeżany co sekundę;
+    // obciążenie to różnica dwóch odczytów przez czas między nimi
+    MetricCounter cpuTimeUs;
+    std::atomic<uint32_t> idle; // 1 - pauza albo ukryte okno, pętla czeka na zdarzenia
+
+    // Opóźnienie wejścia: od zdarzenia SDL strzałki do pokazania pierwszej
+    // klatki z ruchem w tę stronę (us, dokładność zdarzeń SDL to 1 ms)
+    MetricCounter inputs;
+    MetricCounter inputLatencySumUs;
+    MetricCounter inputLatencyHist[METRICS_HIST_BUCKETS];
+
+    // Przeciążenie: kroki nadrobione partią (wątek symulacji obudził się za
+    // późno), kroki porzucone ponad limit nadrabiania i bieżący poziom
+    // jakości rysowania (FrameGovernor.h, 0 - pełna)
+    MetricCounter catchUpTicks;
+    MetricCounter droppedTicks;
+    std::atomic<uint32_t> renderTier;
+
+    // Start metryk (steady_clock, ns) - sumy od startu dzielimy przez
+    // prawdziwy czas, razem z pauzami i bezczynnością
+    uint64_t startNs;
+};
+
+// Czas procesora zużyty przez proces od startu, w mikrosekundach
+inline uint64_t processCpuTimeUs()
+{
+    timespec ts;
+    if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts) != 0)
+        return 0;
+    return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+}
+
+class MetricsRegistry
+{
+public:
+    ~MetricsRegistry()
+    {
+        close();
+    }
+
+    // Blok w shm; gdy się nie uda, liczymy dalej w bloku lokalnym.
+    // Segment tworzymy na wyłączność (O_EXCL): druga gra z tą samą nazwą nie
+    // zeruje liczników pierwszej i nie usuwa jej segmentu przy wyjściu.
+    // Segment po procesie, który już nie żyje (zabity, bez close), zastępujemy.
+    bool publish(const char *name, uint32_t tickRate)
+    {
+        close();
+        int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0644);
+        if (fd < 0 && errno == EEXIST)
+        {
+            if (segmentOwnerAlive(name))
+            {
+                std::cerr << "Metrics segment " << name << " is in use by another game (choose another name)"
+                          << std::endl;
+                return false;
+            }
+            shm_unlink(name);
+            fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0644);
+        }
+        if (fd < 0)
+        {
+            std::cerr << "Cannot create metrics segment: " << name << std::endl;
+            return false;
+        }
+        void *mem = MAP_FAILED;
+        if (ftruncate(fd, sizeof(MetricsBlock)) == 0)
+            mem = mmap(nullptr, sizeof(MetricsBlock), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mem == MAP_FAILED)
+        {
+            std::cerr << "Cannot map metrics segment: " << name << std::endl;
+            shm_unlink(name);
+            return false;
+        }
+        shared = static_cast<MetricsBlock *>(mem);
+        shmName = name;
+        init(*shared, tickRate);
+        std::cout << "[METRICS] Metryki w shm " << name << " (metrics_top)\n";
+        return true;
+    }
+
+    void close()
+    {
+        if (!shared)
+            return;
+        shared->magic.store(0, std::memory_order_release);
+        munmap(shared, sizeof(MetricsBlock));
+        // Segment utworzyliśmy sami (O_EXCL), więc tylko my go usuwamy
+        shm_unlink(shmName.c_str());
+        shared = nullptr;
+    }
+
+    MetricsBlock &block()
+    {
+        return shared ? *shared : local;
+    }
+
+    // ----- pętla renderowania -----
+    void frame(uint64_t frameUs)
+    {
+        MetricsBlock &b = block();
+        b.frames.fetch_add(1, std::memory_order_relaxed);
+        b.frameTimeSumUs.fetch_add(frameUs, std::memory_order_relaxed);
+        b.frameTimeHist[metricsBucket(frameUs)].fetch_add(1, std::memory_order_relaxed);
+        b.heartbeatNs.store(nowNs(), std::memory_order_relaxed);
+    }
+
+    // ----- wątek symulacji -----
+    void tick(int score)
+    {
+        MetricsBlock &b = block();
+        b.ticks.fetch_add(1, std::memory_order_relaxed);
+        b.score.store(score, std::memory_order_relaxed);
+    }
+
+    void inputLatency(uint64_t latencyUs)
+    {
+        MetricsBlock &b = block();
+        b.inputs.fetch_add(1, std::memory_order_relaxed);
+        b.inputLatencySumUs.fetch_add(latencyUs, std::memory_order_relaxed);
+        b.inputLatencyHist[metricsBucket(latencyUs)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void tier(int renderTier)
+    {
+        block().renderTier.store((uint32_t)renderTier, std::memory_order_relaxed);
+    }
+
+    // ----- raz na sekundę z pętli renderowania (też w bezczynności) -----
+    void cpu(uint64_t cpuUs, bool idleNow)
+    {
+        MetricsBlock &b = block();
+        b.cpuTimeUs.store(cpuUs, std::memory_order_relaxed);
+        b.idle.store(idleNow ? 1 : 0, std::memory_order_relaxed);
+        b.heartbeatNs.store(nowNs(), std::memory_order_relaxed);
+    }
+
+    void add(MetricCounter &counter, uint64_t value)
+    {
+        if (value)
+            counter.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    static uint64_t nowNs()
+    {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+private:
+    // Czy istniejący segment należy do działającego procesu (pid z nagłówka);
+    // segment bez ważnego nagłówka (po close albo za krótki) jest porzucony
+    static bool segmentOwnerAlive(const char *name)
+    {
+        int fd = shm_open(name, O_RDONLY, 0);
+        if (fd < 0)
+            return false;
+        void *mem = MAP_FAILED;
+        struct stat info;
+        if (fstat(fd, &info) == 0 && (size_t)info.st_size >= sizeof(MetricsBlock))
+            mem = mmap(nullptr, sizeof(MetricsBlock), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mem == MAP_FAILED)
+            return false;
+        const MetricsBlock *b = static_cast<const MetricsBlock *>(mem);
+        bool alive = b->magic.load(std::memory_order_acquire) == METRICS_MAGIC &&
+                     (kill((pid_t)b->pid, 0) == 0 || errno == EPERM);
+        munmap(mem, sizeof(MetricsBlock));
+        return alive;
+    }
+
+    static void init(MetricsBlock &b, uint32_t tickRate)
+    {
+        b.magic.store(0, std::memory_order_relaxed);
+        b.layoutVersion = METRICS_LAYOUT_VERSION;
+        b.blockSize = sizeof(MetricsBlock);
+        b.pid = (uint32_t)getpid();
+        b.tickRate = tickRate;
+        b.reserved = 0;
+        b.frames.store(0, std::memory_order_relaxed);
+        b.frameTimeSumUs.store(0, std::memory_order_relaxed);
+        for (int i = 0; i < METRICS_HIST_BUCKETS; ++i)
+            b.frameTimeHist[i].store(0, std::memory_order_relaxed);
+        b.ticks.store(0, std::memory_order_relaxed);
+        b.deliveries.store(0, std::memory_order_relaxed);
+        b.goldPickups.store(0, std::memory_order_relaxed);
+        b.pantherHits.store(0, std::memory_order_relaxed);
+        b.restarts.store(0, std::memory_order_relaxed);
+        b.score.store(0, std::memory_order_relaxed);
+        b.heartbeatNs.store(nowNs(), std::memory_order_relaxed);
+        b.cpuTimeUs.store(processCpuTimeUs(), std::memory_order_relaxed);
+        b.idle.store(0, std::memory_order_relaxed);
+        b.inputs.store(0, std::memory_order_relaxed);
+        b.inputLatencySumUs.store(0, std::memory_order_relaxed);
+        for (int i = 0; i < METRICS_HIST_BUCKETS; ++i)
+            b.inputLatencyHist[i].store(0, std::memory_order_relaxed);
+        b.catchUpTicks.store(0, std::memory_order_relaxed);
+        b.droppedTicks.store(0, std::memory_order_relaxed);
+        b.renderTier.store(0, std::memory_order_relaxed);
+        b.startNs = nowNs();
+        b.magic.store(METRICS_MAGIC, std::memory_order_release);
+    }
+
+    MetricsBlock local = {};
+    MetricsBlock *shared = nullptr;
+    std::string shmName;
+};
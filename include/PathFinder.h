@@ -0,0 +1,496 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "Maze.h"
+#include "Tiles.h"
+
+// ----------------- HIERARCHICZNE SZUKANIE DROGI (HPA*) ---------
+// Droga piesza (krok = sąsiedni kafelek, 4 kierunki) na dużych planszach.
+// Plansza jest podzielona na klastry HPA_CLUSTER_SIZE x HPA_CLUSTER_SIZE.
+// Na granicy dwóch klastrów każdy ciągły odcinek otwartych par pól to
+// wejście: krótkie dostaje jedno przejście w środku, długie dwa na końcach.
+// Końce przejść są węzłami grafu abstrakcyjnego; wewnątrz klastra węzły
+// łączą krawędzie z długością drogi (BFS przy budowie), między klastrami -
+// krok długości 1. Zapytanie to dwa małe BFS (start i cel we własnych
+// klastrach) i A* po węzłach, a nie po kafelkach; kafelki drogi odtwarza
+// BFS w klastrach, przez które droga faktycznie idzie.
+//
+// Zmiana kafelka (setPassable) przelicza tylko klaster z tym polem i jego
+// sąsiadów. Droga bywa o kilka procent dłuższa od najkrótszej (przejścia są
+// w stałych miejscach) - dla pantery i bota to bez znaczenia.
+// Tablice robocze zapytań są w obiekcie: jeden PathFinder = jeden wątek.
+
+const int HPA_CLUSTER_SIZE = 16;
+
+// Wejście krótsze niż tyle pól dostaje jedno przejście (w środku)
+const int HPA_SHORT_ENTRANCE = 6;
+
+// Najwięcej węzłów w klastrze: 4 granice po co najwyżej CLUSTER/2 przejść
+const int HPA_MAX_NODES = 2 * HPA_CLUSTER_SIZE;
+
+class PathFinder
+{
+public:
+    // Ściany wg tabeli kafelków; krótsze rzędy Maze to ściana
+    template <typename Grid>
+    void build(const Grid &maze)
+    {
+        int h = mazeHeight(maze);
+        int w = 0;
+        for (int y = 0; y < h; ++y)
+            if (mazeRowWidth(maze, y) > w)
+                w = mazeRowWidth(maze, y);
+        width = w;
+        height = h;
+        passable.assign((size_t)w * h, 0);
+        for (int y = 0; y < h; ++y)
+            for (int x = 0; x < mazeRowWidth(maze, y); ++x)
+                passable[(size_t)y * w + x] = !isSolidTile(tileAt(maze, x, y));
+
+        int area = HPA_CLUSTER_SIZE * HPA_CLUSTER_SIZE;
+        bfsDist.assign(area, -1);
+        bfsQueue.assign(area, 0);
+        startParent.assign(area, -1);
+        segmentParent.assign(area, -1);
+        goalParent.assign(area, -1);
+
+        clustersX = (w + HPA_CLUSTER_SIZE - 1) / HPA_CLUSTER_SIZE;
+        clustersY = (h + HPA_CLUSTER_SIZE - 1) / HPA_CLUSTER_SIZE;
+        int count = clustersX * clustersY;
+        clusters.assign(count, Cluster());
+        rightBorder.assign(count, std::vector<Transition>());
+        bottomBorder.assign(count, std::vector<Transition>());
+        for (int c = 0; c < count; ++c)
+        {
+            buildRightBorder(c);
+            buildBottomBorder(c);
+        }
+        for (int c = 0; c < count; ++c)
+            buildNodes(c);
+        for (int c = 0; c < count; ++c)
+            buildLinks(c);
+
+        size_t ids = (size_t)count * HPA_MAX_NODES + 1;
+        searchCost.assign(ids, 0);
+        searchParent.assign(ids, 0);
+        searchStamp.assign(ids, 0);
+        stamp = 0;
+    }
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+    bool isPassable(int x, int y) const
+    {
+        return x >= 0 && y >= 0 && x < width && y < height && passable[(size_t)y * width + x];
+    }
+
+    // Zmiana kafelka: naprawa lokalna (klaster pola i sąsiedzi)
+    void setPassable(int x, int y, bool open)
+    {
+        if (x < 0 || y < 0 || x >= width || y >= height || isPassable(x, y) == open)
+            return;
+        passable[(size_t)y * width + x] = open;
+
+        int cx = x / HPA_CLUSTER_SIZE, cy = y / HPA_CLUSTER_SIZE;
+        int c = cy * clustersX + cx;
+        // Granice klastra c: własne prawa i dolna, prawa lewego i dolna górnego
+        buildRightBorder(c);
+        buildBottomBorder(c);
+        if (cx > 0)
+            buildRightBorder(c - 1);
+        if (cy > 0)
+            buildBottomBorder(c - clustersX);
+
+        // Węzły i drogi: c i sąsiedzi; połączenia: jeszcze jeden pierścień dalej,
+        // bo numery węzłów sąsiadów mogły się zmienić
+        for (int dy = -1; dy <= 1; ++dy)
+            for (int dx = -1; dx <= 1; ++dx)
+                if ((dx == 0 || dy == 0) && validCluster(cx + dx, cy + dy))
+                    buildNodes((cy + dy) * clustersX + cx + dx);
+        for (int dy = -2; dy <= 2; ++dy)
+            for (int dx = -2; dx <= 2; ++dx)
+                if (std::abs(dx) + std::abs(dy) <= 2 && validCluster(cx + dx, cy + dy))
+                    buildLinks((cy + dy) * clustersX + cx + dx);
+    }
+
+    // Droga z (sx,sy) do (gx,gy): pola y * szerokość + x od startu do celu włącznie.
+    // Zwraca liczbę kroków albo -1, gdy drogi nie ma.
+    int findPath(int sx, int sy, int gx, int gy, std::vector<int> &path)
+    {
+        path.clear();
+        if (!isPassable(sx, sy) || !isPassable(gx, gy))
+            return -1;
+        int start = sy * width + sx, goal = gy * width + gx;
+        int startCluster = clusterOf(sx, sy), goalCluster = clusterOf(gx, gy);
+
+        // W tym samym klastrze najpierw zwykły BFS w jego granicach
+        if (startCluster == goalCluster)
+        {
+            clusterBfs(startCluster, goal, startParent);
+            if (bfsDist[localIndex(startCluster, start)] >= 0)
+            {
+                appendTowardRoot(startCluster, start, startParent, path);
+                return (int)path.size() - 1;
+            }
+        }
+
+        // Start i cel jako tymczasowe węzły: odległości do węzłów ich klastrów
+        const Cluster &sc = clusters[startCluster];
+        const Cluster &gc = clusters[goalCluster];
+        clusterBfs(goalCluster, goal, goalParent);
+        int goalCost[HPA_MAX_NODES];
+        for (size_t i = 0; i < gc.nodes.size(); ++i)
+            goalCost[i] = bfsDist[localIndex(goalCluster, gc.nodes[i])];
+        clusterBfs(startCluster, start, startParent);
+
+        int goalId = (int)searchCost.size() - 1;
+        stamp++;
+        heap.clear();
+        for (size_t i = 0; i < sc.nodes.size(); ++i)
+        {
+            int d = bfsDist[localIndex(startCluster, sc.nodes[i])];
+            if (d >= 0)
+                relax(startCluster * HPA_MAX_NODES + (int)i, d, -1, gx, gy);
+        }
+
+        // A* po węzłach; heurystyka: odległość w linii prostej (Manhattan)
+        bool found = false;
+        while (!heap.empty())
+        {
+            std::pop_heap(heap.begin(), heap.end(), HeapOrder());
+            HeapItem item = heap.back();
+            heap.pop_back();
+            int u = item.id;
+            if (item.cost != searchCost[u])
+                continue;
+            if (u == goalId)
+            {
+                found = true;
+                break;
+            }
+            int k = u / HPA_MAX_NODES, i = u % HPA_MAX_NODES;
+            const Cluster &cl = clusters[k];
+            for (int e = cl.firstEdge[i]; e < cl.firstEdge[i + 1]; ++e)
+                relax(k * HPA_MAX_NODES + cl.edges[e].to, item.cost + cl.edges[e].cost, u, gx, gy);
+            for (size_t l = 0; l < cl.links[i].size(); ++l)
+                relax(cl.links[i][l], item.cost + 1, u, gx, gy);
+            if (k == goalCluster && goalCost[i] >= 0)
+                relax(goalId, item.cost + goalCost[i], u, gx, gy);
+        }
+        if (!found)
+            return -1;
+
+        // Odtworzenie: łańcuch węzłów od końca, potem kafelki
+        chain.clear();
+        for (int u = searchParent[goalId]; u >= 0; u = searchParent[u])
+            chain.push_back(u);
+        std::reverse(chain.begin(), chain.end());
+
+        int first = nodeCell(chain[0]);
+        appendTowardRoot(startCluster, first, startParent, path);
+        std::reverse(path.begin(), path.end());
+        for (size_t s = 1; s < chain.size(); ++s)
+        {
+            int a = chain[s - 1], b = chain[s];
+            int k = a / HPA_MAX_NODES;
+            if (k == b / HPA_MAX_NODES)
+            {
+                // Droga w klastrze: BFS od b, łańcuch rodziców od a (bez pola a)
+                size_t from = path.size();
+                clusterBfs(k, nodeCell(b), segmentParent);
+                appendTowardRoot(k, nodeCell(a), segmentParent, path);
+                path.erase(path.begin() + from);
+            }
+            else
+            {
+                path.push_back(nodeCell(b));
+            }
+        }
+        size_t joined = path.size();
+        appendTowardRoot(goalCluster, nodeCell(chain.back()), goalParent, path);
+        path.erase(path.begin() + joined); // ostatni węzeł już jest
+        return (int)path.size() - 1;
+    }
+
+    // Statystyki grafu abstrakcyjnego
+    int nodeCount() const
+    {
+        int n = 0;
+        for (size_t c = 0; c < clusters.size(); ++c)
+            n += (int)clusters[c].nodes.size();
+        return n;
+    }
+
+private:
+    // Para sąsiednich pól na granicy: a w klastrze lewym/górnym, b w prawym/dolnym
+    struct Transition
+    {
+        int a, b;
+    };
+
+    // Droga wewnątrz klastra do węzła to (numer lokalny); same kafelki
+    // odtwarzamy dopiero dla znalezionej drogi
+    struct Edge
+    {
+        int to, cost;
+    };
+
+    struct Cluster
+    {
+        std::vector<int> nodes;             // pola węzłów
+        std::vector<int> firstEdge;         // krawędzie węzła i: [firstEdge[i], firstEdge[i + 1])
+        std::vector<Edge> edges;
+        std::vector<std::vector<int>> links; // [i] -> węzły w sąsiednich klastrach
+    };
+
+    struct HeapItem
+    {
+        int priority, cost, id;
+    };
+
+    struct HeapOrder
+    {
+        bool operator()(const HeapItem &l, const HeapItem &r) const
+        {
+            // Przy równym priorytecie najpierw dalej od startu (mniej remisów)
+            if (l.priority != r.priority)
+                return l.priority > r.priority;
+            return l.cost < r.cost;
+        }
+    };
+
+    bool validCluster(int cx, int cy) const
+    {
+        return cx >= 0 && cy >= 0 && cx < clustersX && cy < clustersY;
+    }
+
+    int clusterOf(int x, int y) const
+    {
+        return (y / HPA_CLUSTER_SIZE) * clustersX + x / HPA_CLUSTER_SIZE;
+    }
+
+    void clusterBounds(int c, int &x0, int &y0, int &w, int &h) const
+    {
+        x0 = (c % clustersX) * HPA_CLUSTER_SIZE;
+        y0 = (c / clustersX) * HPA_CLUSTER_SIZE;
+        w = std::min(HPA_CLUSTER_SIZE, width - x0);
+        h = std::min(HPA_CLUSTER_SIZE, height - y0);
+    }
+
+    int localIndex(int c, int cell) const
+    {
+        int x0, y0, w, h;
+        clusterBounds(c, x0, y0, w, h);
+        return (cell / width - y0) * HPA_CLUSTER_SIZE + (cell % width - x0);
+    }
+
+    int nodeCell(int id) const
+    {
+        return clusters[id / HPA_MAX_NODES].nodes[id % HPA_MAX_NODES];
+    }
+
+    // Wejścia na granicy: ciągłe odcinki par otwartych pól
+    void addEntrances(std::vector<Transition> &out, int length, int cellA0, int cellB0, int step)
+    {
+        out.clear();
+        int run = 0;
+        for (int i = 0; i <= length; ++i)
+        {
+            bool open = i < length && passable[cellA0 + i * step] && passable[cellB0 + i * step];
+            if (open)
+            {
+                run++;
+                continue;
+            }
+            if (run > 0)
+            {
+                int first = i - run, last = i - 1;
+                if (run < HPA_SHORT_ENTRANCE)
+                {
+                    int mid = (first + last) / 2;
+                    out.push_back(Transition{cellA0 + mid * step, cellB0 + mid * step});
+                }
+                else
+                {
+                    out.push_back(Transition{cellA0 + first * step, cellB0 + first * step});
+                    out.push_back(Transition{cellA0 + last * step, cellB0 + last * step});
+                }
+            }
+            run = 0;
+        }
+    }
+
+    void buildRightBorder(int c)
+    {
+        int x0, y0, w, h;
+        clusterBounds(c, x0, y0, w, h);
+        if (c % clustersX == clustersX - 1)
+        {
+            rightBorder[c].clear();
+            return;
+        }
+        int x = x0 + w - 1;
+        addEntrances(rightBorder[c], h, y0 * width + x, y0 * width + x + 1, width);
+    }
+
+    void buildBottomBorder(int c)
+    {
+        int x0, y0, w, h;
+        clusterBounds(c, x0, y0, w, h);
+        if (c / clustersX == clustersY - 1)
+        {
+            bottomBorder[c].clear();
+            return;
+        }
+        int y = y0 + h - 1;
+        addEntrances(bottomBorder[c], w, y * width + x0, (y + 1) * width + x0, 1);
+    }
+
+    // Wszystkie przejścia klastra jako (pole tutaj, pole u sąsiada)
+    template <typename Visit>
+    void forEachTransition(int c, Visit visit) const
+    {
+        int cx = c % clustersX, cy = c / clustersX;
+        for (size_t t = 0; t < rightBorder[c].size(); ++t)
+            visit(rightBorder[c][t].a, rightBorder[c][t].b, c + 1);
+        for (size_t t = 0; t < bottomBorder[c].size(); ++t)
+            visit(bottomBorder[c][t].a, bottomBorder[c][t].b, c + clustersX);
+        if (cx > 0)
+            for (size_t t = 0; t < rightBorder[c - 1].size(); ++t)
+                visit(rightBorder[c - 1][t].b, rightBorder[c - 1][t].a, c - 1);
+        if (cy > 0)
+            for (size_t t = 0; t < bottomBorder[c - clustersX].size(); ++t)
+                visit(bottomBorder[c - clustersX][t].b, bottomBorder[c - clustersX][t].a, c - clustersX);
+    }
+
+    int findNode(const Cluster &cl, int cell) const
+    {
+        for (size_t i = 0; i < cl.nodes.size(); ++i)
+            if (cl.nodes[i] == cell)
+                return (int)i;
+        return -1;
+    }
+
+    // Węzły klastra i drogi między nimi
+    void buildNodes(int c)
+    {
+        Cluster &cl = clusters[c];
+        cl.nodes.clear();
+        forEachTransition(c, [&](int here, int, int)
+                          {
+            if (findNode(cl, here) < 0 && (int)cl.nodes.size() < HPA_MAX_NODES)
+                cl.nodes.push_back(here); });
+
+        int n = (int)cl.nodes.size();
+        // Odległości są symetryczne: BFS od i wypełnia wiersz i kolumnę
+        int dist[HPA_MAX_NODES][HPA_MAX_NODES];
+        for (int i = 0; i < n; ++i)
+        {
+            dist[i][i] = 0;
+            clusterBfs(c, cl.nodes[i], segmentParent);
+            for (int j = i + 1; j < n; ++j)
+                dist[i][j] = dist[j][i] = bfsDist[localIndex(c, cl.nodes[j])];
+        }
+        cl.firstEdge.assign(n + 1, 0);
+        cl.edges.clear();
+        cl.links.assign(n, std::vector<int>());
+        for (int i = 0; i < n; ++i)
+        {
+            cl.firstEdge[i] = (int)cl.edges.size();
+            for (int j = 0; j < n; ++j)
+                if (dist[i][j] > 0)
+                    cl.edges.push_back(Edge{j, dist[i][j]});
+        }
+        cl.firstEdge[n] = (int)cl.edges.size();
+    }
+
+    void buildLinks(int c)
+    {
+        Cluster &cl = clusters[c];
+        cl.links.assign(cl.nodes.size(), std::vector<int>());
+        forEachTransition(c, [&](int here, int there, int other)
+                          {
+            int i = findNode(cl, here);
+            int j = findNode(clusters[other], there);
+            if (i >= 0 && j >= 0)
+                cl.links[i].push_back(other * HPA_MAX_NODES + j); });
+    }
+
+    // BFS w granicach klastra od pola root: bfsDist i parent (indeksy lokalne)
+    void clusterBfs(int c, int root, std::vector<int> &parent)
+    {
+        int x0, y0, w, h;
+        clusterBounds(c, x0, y0, w, h);
+        std::fill(bfsDist.begin(), bfsDist.end(), -1);
+        int head = 0, tail = 0;
+        int r = localIndex(c, root);
+        bfsDist[r] = 0;
+        parent[r] = -1;
+        bfsQueue[tail++] = r;
+        static const int DX[4] = {1, -1, 0, 0};
+        static const int DY[4] = {0, 0, 1, -1};
+        while (head < tail)
+        {
+            int l = bfsQueue[head++];
+            int lx = l % HPA_CLUSTER_SIZE, ly = l / HPA_CLUSTER_SIZE;
+            for (int d = 0; d < 4; ++d)
+            {
+                int nx = lx + DX[d], ny = ly + DY[d];
+                if (nx < 0 || ny < 0 || nx >= w || ny >= h)
+                    continue;
+                int nl = ny * HPA_CLUSTER_SIZE + nx;
+                if (bfsDist[nl] >= 0 || !passable[(size_t)(y0 + ny) * width + x0 + nx])
+                    continue;
+                bfsDist[nl] = bfsDist[l] + 1;
+                parent[nl] = l;
+                bfsQueue[tail++] = nl;
+            }
+        }
+    }
+
+    // Pola od cell do korzenia BFS (włącznie z oboma)
+    void appendTowardRoot(int c, int cell, const std::vector<int> &parent, std::vector<int> &out) const
+    {
+        int x0, y0, w, h;
+        clusterBounds(c, x0, y0, w, h);
+        for (int l = localIndex(c, cell); l >= 0; l = parent[l])
+            out.push_back((y0 + l / HPA_CLUSTER_SIZE) * width + x0 + l % HPA_CLUSTER_SIZE);
+    }
+
+    void relax(int id, int cost, int parent, int gx, int gy)
+    {
+        if (searchStamp[id] == stamp && searchCost[id] <= cost)
+            return;
+        searchStamp[id] = stamp;
+        searchCost[id] = cost;
+        searchParent[id] = parent;
+        int h = 0;
+        if (id != (int)searchCost.size() - 1)
+        {
+            int cell = nodeCell(id);
+            h = std::abs(cell % width - gx) + std::abs(cell / width - gy);
+        }
+        heap.push_back(HeapItem{cost + h, cost, id});
+        std::push_heap(heap.begin(), heap.end(), HeapOrder());
+    }
+
+    int width = 0, height = 0;
+    int clustersX = 0, clustersY = 0;
+    std::vector<uint8_t> passable;
+    std::vector<Cluster> clusters;
+    std::vector<std::vector<Transition>> rightBorder, bottomBorder;
+
+    // Tablice robocze zapytań (bez alokacji po pierwszym użyciu)
+    std::vector<int> searchCost, searchParent;
+    std::vector<uint32_t> searchStamp;
+    uint32_t stamp = 0;
+    std::vector<HeapItem> heap;
+    std::vector<int> chain;
+    std::vector<int> bfsDist, bfsQueue;
+    std::vector<int> startParent, goalParent, segmentParent;
+};
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstdint>
+
+// ----------------- LOSOWOŚĆ Z ZIARNA ---------
+// xoshiro256** (Blackman, Vigna): 4 słowa stanu, kilka instrukcji na liczbę,
+// bez globalnego stanu - każdy użytkownik ma własny obiekt.
+// Jedno ziarno główne (np. -s w narzędziach) rozdzielamy na niezależne
+// strumienie: rngStreamSeed(ziarno, podsystem, numer) miesza wszystkie trzy
+// przez splitmix64, więc plansza 7 z generatora i przebieg 7 bota nie dostaną
+// tych samych liczb. Numer to przebieg/plansza, a nie wątek - wtedy wynik
+// nie zależy od liczby wątków ani kolejności ich pracy.
+//
+// Losowania (below, real01, shuffle) są zdefiniowane tutaj, a nie przez
+// std::uniform_*_distribution, których wynik zależy od biblioteki
+// standardowej - to samo ziarno daje to samo na każdym kompilatorze.
+
+enum RngSubsystem
+{
+    RNG_MAZE_GEN = 1,
+    RNG_SIM_BOT = 2,
+};
+
+inline uint64_t splitMix64(uint64_t &state)
+{
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+inline uint64_t rngStreamSeed(uint64_t master, RngSubsystem subsystem, uint64_t index)
+{
+    uint64_t s = master;
+    uint64_t h = splitMix64(s);
+    s = h ^ ((uint64_t)subsystem << 32);
+    h = splitMix64(s);
+    s = h ^ index;
+    return splitMix64(s);
+}
+
+class Rng
+{
+public:
+    // Zgodne z UniformRandomBitGenerator (gdyby ktoś potrzebował <algorithm>)
+    typedef uint64_t result_type;
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~(result_type)0; }
+
+    explicit Rng(uint64_t seed = 0)
+    {
+        reseed(seed);
+    }
+
+    void reseed(uint64_t seed)
+    {
+        // splitmix64 rozkłada ziarno na stan; stan z samych zer jest niemożliwy
+        for (int i = 0; i < 4; ++i)
+            s[i] = splitMix64(seed);
+    }
+
+    uint64_t next()
+    {
+        uint64_t result = rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    result_type operator()() { return next(); }
+
+    // Równomiernie z [0, n), n > 0 (Lemire: mnożenie zamiast dzielenia,
+    // odrzucanie tylko przy rzadkim obciążeniu)
+    uint32_t below(uint32_t n)
+    {
+        uint64_t m = (next() >> 32) * n;
+        uint32_t low = (uint32_t)m;
+        if (low < n)
+        {
+            uint32_t threshold = (0u - n) % n;
+            while (low < threshold)
+            {
+                m = (next() >> 32) * n;
+                low = (uint32_t)m;
+            }
+        }
+        return (uint32_t)(m >> 32);
+    }
+
+    // Równomiernie z [lo, hi]
+    int range(int lo, int hi)
+    {
+        return lo + (int)below((uint32_t)(hi - lo) + 1);
+    }
+
+    // [0, 1) z 53 bitów
+    double real01()
+    {
+        return (next() >> 11) * 0x1.0p-53;
+    }
+
+    bool coin()
+    {
+        return next() >> 63;
+    }
+
+    template <typename T>
+    void shuffle(T *first, int count)
+    {
+        for (int i = count - 1; i > 0; --i)
+        {
+            int j = (int)below((uint32_t)i + 1);
+            T tmp = first[i];
+            first[i] = first[j];
+            first[j] = tmp;
+        }
+    }
+
+private:
+    static uint64_t rotl(uint64_t x, int k)
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    uint64_t s[4];
+};
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+#include "Arena.h"
+
+// ----------------- GRUPOWANIE PROSTOKĄTÓW ---------
+// Zamiast SDL_SetRenderDrawColor + SDL_RenderFillRect dla każdego "piksela"
+// sprajta zbieramy prostokąty według koloru w pamięci klatki i wysyłamy je
+// jednym SDL_RenderFillRects na kolor. Kolejność kolorów przy flush() jest
+// dowolna, więc w jednej partii nie mogą być nakładające się prostokąty
+// (plansza - tak, gracz na panterze - nie; wtedy flush() po każdym obiekcie).
+
+const int RECT_BATCH_MAX_COLORS = 16;
+const int RECT_BATCH_CAPACITY = 1024;
+
+class RectBatcher
+{
+public:
+    RectBatcher(SDL_Renderer *renderer, Arena &scratch) : renderer(renderer), scratch(scratch) {}
+    ~RectBatcher() { flush(); }
+
+    void add(SDL_Color color, const SDL_Rect &rect)
+    {
+        Batch *batch = findBatch(color);
+        if (!batch)
+        {
+            // Brak pamięci klatki - rysujemy od razu
+            SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+            SDL_RenderFillRect(renderer, &rect);
+            return;
+        }
+        if (batch->count == RECT_BATCH_CAPACITY)
+            flushBatch(*batch);
+        batch->rects[batch->count++] = rect;
+    }
+
+    void flush()
+    {
+        for (int i = 0; i < batchCount; ++i)
+            flushBatch(batches[i]);
+    }
+
+private:
+    struct Batch
+    {
+        SDL_Color color;
+        SDL_Rect *rects;
+        int count;
+    };
+
+    Batch *findBatch(SDL_Color color)
+    {
+        for (int i = 0; i < batchCount; ++i)
+        {
+            const SDL_Color &c = batches[i].color;
+            if (c.r == color.r && c.g == color.g && c.b == color.b && c.a == color.a)
+                return &batches[i];
+        }
+        if (batchCount == RECT_BATCH_MAX_COLORS)
+            return nullptr;
+        SDL_Rect *rects = scratch.allocArray<SDL_Rect>(RECT_BATCH_CAPACITY);
+        if (!rects)
+            return nullptr;
+        Batch &batch = batches[batchCount++];
+        batch.color = color;
+        batch.rects = rects;
+        batch.count = 0;
+        return &batch;
+    }
+
+    void flushBatch(Batch &batch)
+    {
+        if (batch.count == 0)
+            return;
+        SDL_SetRenderDrawColor(renderer, batch.color.r, batch.color.g, batch.color.b, batch.color.a);
+        SDL_RenderFillRects(renderer, batch.rects, batch.count);
+        batch.count = 0;
+    }
+
+    SDL_Renderer *renderer;
+    Arena &scratch;
+    Batch batches[RECT_BATCH_MAX_COLORS];
+    int batchCount = 0;
+};
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// ----------------- TEST RENDEROWANIA BEZ OKNA ---------
+// Gra z --render-test SKRYPT rysuje do powierzchni w pamięci (software
+// renderer SDL, bez okna i bez sterownika wideo), krok symulacji po kroku,
+// według skryptu poleceń. Każda klatka dostaje skrót pikseli, porównywany
+// ze "złotymi" skrótami z pliku - zmiana w rysowaniu (atlas, partie,
+// brudne prostokąty) musi dać te same piksele, a raport czasów pokazuje,
+// czy jest szybciej.
+//
+// Skrypt, jedno polecenie na linię, '#' - komentarz:
+//   30 right        w kroku 30 strzałka w prawo (up/down/left/right)
+//   400 rewind      Backspace; też restart, lowres (F2), heat (F4)
+//   end 900         długość sesji w krokach (domyślnie 2 s po ostatnim poleceniu)
+
+enum ScriptCommand
+{
+    SCRIPT_UP,
+    SCRIPT_DOWN,
+    SCRIPT_LEFT,
+    SCRIPT_RIGHT,
+    SCRIPT_RESTART,
+    SCRIPT_REWIND,
+    SCRIPT_LOWRES,
+    SCRIPT_HEAT,
+    SCRIPT_COMMAND_COUNT
+};
+
+static const char *const SCRIPT_COMMAND_NAMES[SCRIPT_COMMAND_COUNT] = {
+    "up", "down", "left", "right", "restart", "rewind", "lowres", "heat"};
+
+struct ScriptEvent
+{
+    uint32_t tick;
+    ScriptCommand command;
+};
+
+struct RenderScript
+{
+    std::vector<ScriptEvent> events; // posortowane po kroku
+    uint32_t ticks = 0;
+};
+
+inline bool loadRenderScript(const char *path, RenderScript &script, int tickRate)
+{
+    std::ifstream in(path);
+    if (!in)
+    {
+        std::cerr << "Cannot open render script: " << path << std::endl;
+        return false;
+    }
+
+    script.events.clear();
+    script.ticks = 0;
+    bool hasEnd = false;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line))
+    {
+        lineNumber++;
+        size_t comment = line.find('#');
+        if (comment != std::string::npos)
+            line.resize(comment);
+
+        std::istringstream fields(line);
+        std::string first, second;
+        if (!(fields >> first))
+            continue;
+        if (!(fields >> second))
+        {
+            std::cerr << "Render script " << path << ":" << lineNumber << ": expected two fields" << std::endl;
+            return false;
+        }
+
+        if (first == "end")
+        {
+            script.ticks = (uint32_t)std::strtoul(second.c_str(), nullptr, 10);
+            hasEnd = true;
+            continue;
+        }
+
+        ScriptEvent event;
+        event.tick = (uint32_t)std::strtoul(first.c_str(), nullptr, 10);
+        int command = 0;
+        while (command < SCRIPT_COMMAND_COUNT && second != SCRIPT_COMMAND_NAMES[command])
+            command++;
+        if (command == SCRIPT_COMMAND_COUNT)
+        {
+            std::cerr << "Render script " << path << ":" << lineNumber << ": unknown command " << second << std::endl;
+            return false;
+        }
+        event.command = (ScriptCommand)command;
+        script.events.push_back(event);
+    }
+
+    // Kolejność poleceń w tym samym kroku zostaje taka jak w pliku
+    std::stable_sort(script.events.begin(), script.events.end(),
+                     [](const ScriptEvent &a, const ScriptEvent &b)
+                     { return a.tick < b.tick; });
+    if (!hasEnd)
+        script.ticks = (script.events.empty() ? 0 : script.events.back().tick) + 2 * tickRate;
+    return true;
+}
+
+// FNV-1a po pikselach ARGB8888 bez kanału alfa (alfa tła zależy od
+// renderera, a na ekranie i tak jej nie widać); wiersze bez wyrównania pitch
+inline uint64_t hashFramePixels(const void *pixels, int width, int height, int pitch)
+{
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (int y = 0; y < height; ++y)
+    {
+        const uint32_t *row = (const uint32_t *)((const uint8_t *)pixels + (size_t)y * pitch);
+        for (int x = 0; x < width; ++x)
+        {
+            hash ^= row[x] & 0x00FFFFFFu;
+            hash *= 0x100000001B3ull;
+        }
+    }
+    return hash;
+}
+
+// Złote skróty: jedna linia "klatka skrót" (szesnastkowo), numeracja od 0
+inline bool loadGoldenHashes(const char *path, std::vector<uint64_t> &hashes)
+{
+    FILE *file = std::fopen(path, "r");
+    if (!file)
+        return false;
+    hashes.clear();
+    unsigned long frame;
+    unsigned long long hash;
+    while (std::fscanf(file, "%lu %llx", &frame, &hash) == 2)
+    {
+        if (frame != hashes.size())
+            break;
+        hashes.push_back(hash);
+    }
+    std::fclose(file);
+    return true;
+}
+
+inline bool saveGoldenHashes(const char *path, const std::vector<uint64_t> &hashes)
+{
+    FILE *file = std::fopen(path, "w");
+    if (!file)
+    {
+        std::cerr << "Cannot write golden hashes: " << path << std::endl;
+        return false;
+    }
+    for (size_t i = 0; i < hashes.size(); ++i)
+        std::fprintf(file, "%zu %016llx\n", i, (unsigned long long)hashes[i]);
+    return std::fclose(file) == 0;
+}
+
+// Percentyl czasów klatek (kopia, bo sortujemy)
+inline uint64_t renderTimePercentile(std::vector<uint64_t> times, int percent)
+{
+    if (times.empty())
+        return 0;
+    size_t index = (times.size() - 1) * percent / 100;
+    std::nth_element(times.begin(), times.begin() + index, times.end());
+    return times[index];
+}
@@ -0,0 +1,701 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+
+#include "Arena.h"
+#include "Behaviour.h"
+#include "Heatmap.h"
+#include "Maze.h"
+#include "FixedPoint.h"
+
+// ----------------- SYMULACJA GRY (bez SDL) ---------
+// Cała logika ruchu, zbierania złota i pantery. Gra woła ją z osobnego wątku
+// symulacji, narzędzia mogą ją uruchamiać bez okna.
+
+// ----------------- USTAWIENIA ------------------------
+
+// Rozmiar kafelka (tunel ma 1 kafelek szerokości)
+const int CELL_SIZE = 24;
+
+// Rozmiar "logiczne" sprajtów (używane do snapowania i kolizji bounding-box)
+// const int SPRITE_WIDTH do wykorzystania być może później
+const int CELL_SPRITE_WIDTH = 20;
+const int CELL_SPRITE_HEIGHT = 20;
+
+const int PLAYER_WIDTH = 20;
+const int PLAYER_HEIGHT = 20;
+const int START_WIDTH = 20;
+const int START_HEIGHT = 20;
+const int GOLD_WIDTH = 20;
+const int GOLD_HEIGHT = 20;
+const int GOLD2_WIDTH = 20;
+const int GOLD2_HEIGHT = 20;
+const int PANTHER_WIDTH = 20;
+const int PANTHER_HEIGHT = 20;
+
+// Kafelek startowy pantery
+const int PANTHER_START_CELL_X = 11;
+const int PANTHER_START_CELL_Y = 6;
+
+// Kroki symulacji, przez które pantera po zabraniu złota jest niegroźna
+// (180 kroków = 3 sekundy przy SIM_TICK_RATE 60)
+const int PANTHER_DISABLE_TIME = 180;
+
+// Szybkość ruchu: 2 piksele na klatkę
+const fixed_t speed = 2 * FP_ONE;
+
+// Prędkość ruchu pantery: 1 piksel/klatkę
+const fixed_t pantherSpeed = FP_ONE;
+
+// Częstotliwość kroków symulacji (1 krok = dawna 1 klatka)
+const int SIM_TICK_RATE = 60;
+
+// Skręt w ścianę w trakcie ruchu czeka tyle kroków na najbliższe skrzyżowanie
+// (250 ms; gra włącza bufor przez GameState::turnBufferTicks, narzędzia nie)
+const int TURN_BUFFER_TICKS = 15;
+
+// Pozycja (lewy górny róg) obiektu o rozmiarze size wyśrodkowanego w kafelku cell
+inline fixed_t cellToPos(int cell, int size)
+{
+    return toFixed(cell * CELL_SIZE) + toFixed(CELL_SIZE - size) / 2;
+}
+
+// Kafelek, w którym leży środek obiektu o rozmiarze size
+inline int posToCell(fixed_t pos, int size)
+{
+    return (pos + toFixed(size / 2)) / toFixed(CELL_SIZE);
+}
+
+// ----------------- STAN GRY --------------------
+struct Panther
+{
+    fixed_t posX = 0, posY = 0;
+    int dirX = 0; // Kierunek na osi X: 1 = w prawo, -1 = w lewo
+    int dirY = 1; // Kierunek na osi Y: 1 = w dół, -1 = w górę
+
+    // czy pantera jest w trybie „bezpiecznym”? (jak długo - patrz pantherBehaviour)
+    bool isDisabled = false;
+    uint32_t wakeTick = 0; // krok, w którym wyłączona pantera wraca
+
+    BehaviourHandle behaviour; // jej coroutine (World.h przestawia ją w kole czasu)
+};
+
+// Kafelki planszy dzielimy na strony po tyle pól (kolejno w tablicy tiles);
+// World.h zapisuje tylko strony zmienione od ostatniego zapisu
+const int TILE_PAGE_SIZE = 64;
+const uint16_t TILE_PAGE_DIRTY = 0xFFFF;
+
+// Kolejność kierunków w tabeli ślizgów
+enum SlideDir
+{
+    SLIDE_UP,
+    SLIDE_DOWN,
+    SLIDE_LEFT,
+    SLIDE_RIGHT
+};
+
+inline int slideDirIndex(int dirX, int dirY)
+{
+    if (dirX == 1)
+        return SLIDE_RIGHT;
+    if (dirX == -1)
+        return SLIDE_LEFT;
+    if (dirY == 1)
+        return SLIDE_DOWN;
+    return SLIDE_UP;
+}
+
+// Wszystko, co należy do poziomu (plansza, tablica panter, tabela ślizgów),
+// leży w arenie poziomu - GameState trzyma tylko wskaźniki do niej.
+// Restart poziomu to arena.reset() i ponowne initGameState, bez sterty.
+struct GameState
+{
+    // Labirynt (1=ściana, 0=ścieżka, 5=życie, 4 - złoto, 3 - złoto podwójne)
+    TileGrid maze;
+
+    // Dla każdego pola i kierunku: indeks pola (y * width + x), na którym
+    // kończy się ślizg. Ściany się nie zmieniają, więc liczymy raz na poziom.
+    const uint16_t *slideTargets = nullptr;
+
+    Panther *panthers = nullptr;
+    int pantherCount = 0;
+
+    // Zwiększany przy każdej zmianie kafelka (render nie musi porównywać całej planszy)
+    unsigned tilesVersion = 0;
+
+    // Dla każdej strony kafelków: numer strony w TilePagePool (World.h) z tą
+    // samą zawartością albo TILE_PAGE_DIRTY, gdy strona zmieniła się od zapisu
+    uint16_t *tilePages = nullptr;
+    int tilePageCount = 0;
+
+    // Licznik punktów, flaga złota
+    int score = 0;
+    bool hasGold = false;
+
+    // Zdarzenia od startu poziomu (metryki, Metrics.h)
+    int goldPickups = 0;
+    int pantherHits = 0;
+
+    // Pozycja gracza w 1/256 piksela (lewy górny róg) i pozycja docelowa
+    fixed_t posPlayerX = 0, posPlayerY = 0;
+    fixed_t targetPlayerPosX = 0, targetPlayerPosY = 0;
+
+    // Czy obecnie animujemy ruch
+    bool isMoving = false;
+
+    // Kierunek w sensie kafelków (np. (1,0) to w prawo)
+    int dirCellX = 0, dirCellY = 0;
+
+    // Skręt zapamiętany w trakcie ruchu; wykonywany na środku pierwszego pola,
+    // z którego da się w tę stronę pójść (pendingTurnTicks == 0 - brak)
+    int pendingTurnX = 0, pendingTurnY = 0;
+    int pendingTurnTicks = 0;
+
+    // pozycja drzwi startowych (skarbca)
+    fixed_t posStartX = 0, posStartY = 0;
+
+    bool justCollidedWithPanther = false;
+
+    // Liczniki kafelków (nullptr = nie zbieramy); należą do wołającego
+    TileHeatmap *heatmap = nullptr;
+
+    // Komunikaty na konsolę (narzędzia bez okna je wyłączają)
+    bool verbose = true;
+
+    // Ile kroków czeka buforowany skręt (0 - bez bufora, jak dawniej:
+    // skręt w ścianę zatrzymuje gracza)
+    int turnBufferTicks = 0;
+
+    // Zachowania panter (Behaviour.h); ramki w arenie poziomu trzymają
+    // referencję do tego GameState, więc stanu z zachowaniami nie kopiujemy
+    BehaviourScheduler behaviours;
+};
+
+// Miejsce na ramkę coroutine jednego zachowania pantery (z zapasem)
+const size_t PANTHER_BEHAVIOUR_BYTES = 256;
+
+// Ile bajtów areny potrzeba na poziom o danych wymiarach
+inline size_t levelArenaBytes(int width, int height, int pantherCount)
+{
+    size_t cells = (size_t)width * height;
+    size_t pages = (cells + TILE_PAGE_SIZE - 1) / TILE_PAGE_SIZE;
+    return cells + cells * 4 * sizeof(uint16_t) + pages * sizeof(uint16_t) +
+           pantherCount * sizeof(Panther) +
+           2 * BEHAVIOUR_WHEEL_SLOTS * sizeof(BehaviourPromise *) +
+           pantherCount * PANTHER_BEHAVIOUR_BYTES + (6 + pantherCount) * alignof(std::max_align_t);
+}
+
+inline Behaviour pantherBehaviour(Arena &, GameState &game, int index);
+
+// Ustawienie stanu początkowego dla danego labiryntu; dane poziomu trafiają
+// do areny. false, gdy arena jest za mała albo plansza za duża dla tabeli ślizgów.
+// Grid to Maze (plik), TileGrid albo Level (plansze wbudowane, Levels.h).
+template <typename Grid>
+inline bool initGameState(GameState &game, Arena &arena, const Grid &maze)
+{
+    // Ustawienia wołającego przeżywają restart
+    TileHeatmap *heatmap = game.heatmap;
+    bool verbose = game.verbose;
+    int turnBufferTicks = game.turnBufferTicks;
+    game = GameState();
+    game.heatmap = heatmap;
+    game.verbose = verbose;
+    game.turnBufferTicks = turnBufferTicks;
+
+    int height = mazeHeight(maze);
+    int width = 0;
+    for (int y = 0; y < height; ++y)
+        if (mazeRowWidth(maze, y) > width)
+            width = mazeRowWidth(maze, y);
+    int cells = width * height;
+    if (cells == 0 || cells > 0xFFFF)
+        return false;
+
+    int pages = (cells + TILE_PAGE_SIZE - 1) / TILE_PAGE_SIZE;
+    uint8_t *tiles = arena.allocArray<uint8_t>(cells);
+    uint16_t *slides = arena.allocArray<uint16_t>((size_t)cells * 4);
+    uint16_t *tilePages = arena.allocArray<uint16_t>(pages);
+    Panther *panthers = arena.allocArray<Panther>(1);
+    if (!tiles || !slides || !tilePages || !panthers)
+        return false;
+    for (int p = 0; p < pages; ++p)
+        tilePages[p] = TILE_PAGE_DIRTY;
+    game.tilePages = tilePages;
+    game.tilePageCount = pages;
+
+    // Krótsze rzędy dopełniamy ścianami
+    for (int y = 0; y < height; ++y)
+        for (int x = 0; x < width; ++x)
+            tiles[y * width + x] = x < mazeRowWidth(maze, y) ? (uint8_t)tileAt(maze, x, y) : 1;
+    game.maze.width = width;
+    game.maze.height = height;
+    game.maze.tiles = tiles;
+
+    static const int SLIDE_DX[4] = {0, 0, -1, 1};
+    static const int SLIDE_DY[4] = {-1, 1, 0, 0};
+    for (int y = 0; y < height; ++y)
+        for (int x = 0; x < width; ++x)
+            for (int d = 0; d < 4; ++d)
+            {
+                int tx, ty;
+                computeTargetCell(game.maze, x, y, SLIDE_DX[d], SLIDE_DY[d], tx, ty);
+                slides[(y * width + x) * 4 + d] = (uint16_t)(ty * width + tx);
+            }
+    game.slideTargets = slides;
+
+    // Startowa pozycja (wycentrowana w kafelku 19,1)
+    game.posPlayerX = cellToPos(START_CELL_X, PLAYER_WIDTH);
+    game.posPlayerY = cellToPos(START_CELL_Y, PLAYER_HEIGHT);
+
+    game.posStartX = cellToPos(VAULT_CELL_X, GOLD_WIDTH);
+    game.posStartY = cellToPos(VAULT_CELL_Y, GOLD_HEIGHT);
+
+    // Początkowo stoimy w miejscu
+    game.targetPlayerPosX = game.posPlayerX;
+    game.targetPlayerPosY = game.posPlayerY;
+
+    panthers[0].posX = cellToPos(PANTHER_START_CELL_X, PANTHER_WIDTH);
+    panthers[0].posY = cellToPos(PANTHER_START_CELL_Y, PANTHER_HEIGHT);
+    game.panthers = panthers;
+    game.pantherCount = 1;
+
+    if (!game.behaviours.init(arena))
+        return false;
+    for (int p = 0; p < game.pantherCount; ++p)
+    {
+        Behaviour behaviour = pantherBehaviour(arena, game, p);
+        if (!game.behaviours.spawn(behaviour))
+            return false;
+        panthers[p].behaviour = behaviour.handle;
+    }
+    return true;
+}
+
+// SPRAWDZENIE KOLIZJI Z BOUNDING-BOXEM PANTERY
+inline bool checkPantherBoxCollision(fixed_t x1, fixed_t y1, int width1, int height1,
+                                     fixed_t x2, fixed_t y2, int width2, int height2)
+{
+    fixed_t w1 = toFixed(width1), h1 = toFixed(height1);
+    fixed_t w2 = toFixed(width2), h2 = toFixed(height2);
+
+    // If one rectangle is on left side of other
+    if (x1 + w1 <= x2)
+        return false;
+    if (x2 + w2 <= x1)
+        return false;
+    if (y1 + h1 <= y2)
+        return false;
+    if (y2 + h2 <= y1)
+        return false;
+    return true;
+}
+
+// SPRAWDZENIE KOLIZJI Z BOUNDING-BOXEM STARTU
+inline bool checkStartBoxCollision(fixed_t x1, fixed_t y1, int width1, int height1,
+                                   fixed_t x2, fixed_t y2, int width2, int height2)
+{
+    fixed_t w1 = toFixed(width1), h1 = toFixed(height1);
+    fixed_t w2 = toFixed(width2), h2 = toFixed(height2);
+
+    // If one rectangle is on left side of other
+    if (x1 + w1 <= x2)
+        return false;
+    if (x2 + w2 <= x1)
+        return false;
+    if (y1 + h1 <= y2)
+        return false;
+    if (y2 + h2 <= y1)
+        return false;
+    return true;
+}
+
+// (Opcjonalna) funkcja kolizji z rogami bounding-boxa
+inline bool checkCollisionWithWalls(fixed_t newX, fixed_t newY, const TileGrid &maze)
+{
+    fixed_t left = newX;
+    fixed_t top = newY;
+    fixed_t right = newX + toFixed(PLAYER_WIDTH - 1);
+    fixed_t bottom = newY + toFixed(PLAYER_HEIGHT - 1);
+
+    auto isWallAtPixel = [&](fixed_t px, fixed_t py)
+    {
+        if (px < 0 || py < 0)
+            return true; // poza mapą
+        int tileX = px / toFixed(CELL_SIZE);
+        int tileY = py / toFixed(CELL_SIZE);
+        if (tileY < 0 || tileY >= maze.height ||
+            tileX < 0 || tileX >= maze.width)
+        {
+            return true; // poza tablicą
+        }
+        return isSolidTile(maze.at(tileX, tileY));
+    };
+
+    if (isWallAtPixel(left, top))
+        return true;
+    if (isWallAtPixel(right, top))
+        return true;
+    if (isWallAtPixel(left, bottom))
+        return true;
+    if (isWallAtPixel(right, bottom))
+        return true;
+
+    return false;
+}
+
+// (Opcjonalna) funkcja kolizji z rogami bounding-boxa pantery
+inline bool checkPantherCollisionWithWalls(fixed_t newX, fixed_t newY, const TileGrid &maze)
+{
+    fixed_t left = newX;
+    fixed_t top = newY;
+    fixed_t right = newX + toFixed(PANTHER_WIDTH - 1);
+    fixed_t bottom = newY + toFixed(PANTHER_HEIGHT - 1);
+
+    auto isWallAtPixel = [&](fixed_t px, fixed_t py)
+    {
+        if (px < 0 || py < 0)
+            return true; // poza mapą
+        int tileX = px / toFixed(CELL_SIZE);
+        int tileY = py / toFixed(CELL_SIZE);
+        if (tileY < 0 || tileY >= maze.height ||
+            tileX < 0 || tileX >= maze.width)
+        {
+            return true; // poza tablicą
+        }
+        return isSolidTile(maze.at(tileX, tileY));
+    };
+
+    if (isWallAtPixel(left, top))
+        return true;
+    if (isWallAtPixel(right, top))
+        return true;
+    if (isWallAtPixel(left, bottom))
+        return true;
+    if (isWallAtPixel(right, bottom))
+        return true;
+
+    return false;
+}
+
+// Zmiana kafelka (zawsze przez tę funkcję, żeby podbić wersję planszy)
+inline void setTile(GameState &game, int x, int y, int value)
+{
+    game.maze.at(x, y) = (uint8_t)value;
+    game.tilesVersion++;
+    game.tilePages[(y * game.maze.width + x) / TILE_PAGE_SIZE] = TILE_PAGE_DIRTY;
+}
+
+inline void recordHeat(GameState &game, int layer, int x, int y)
+{
+    if (game.heatmap)
+        game.heatmap->add(layer, x, y);
+}
+
+// Pole (y * width + x), na którym kończy się ślizg z (cellX, cellY)
+inline int slideTargetOf(const GameState &game, int cellX, int cellY, int dirX, int dirY)
+{
+    return game.slideTargets[(cellY * game.maze.width + cellX) * 4 + slideDirIndex(dirX, dirY)];
+}
+
+// Naciśnięcie strzałki: (dirX, dirY) to kierunek w kafelkach, np. (0,-1) = w górę
+inline void handleDirectionInput(GameState &game, int dirX, int dirY)
+{
+    // Określamy aktualną komórkę (środek gracza)
+    int cellX = posToCell(game.posPlayerX, PLAYER_WIDTH);
+    int cellY = posToCell(game.posPlayerY, PLAYER_HEIGHT);
+
+    // Skręt w ścianę w trakcie ruchu nie zatrzymuje gracza - czeka na
+    // skrzyżowanie (applyBufferedTurn w stepSimulation)
+    if (game.isMoving && game.turnBufferTicks > 0 &&
+        slideTargetOf(game, cellX, cellY, dirX, dirY) == cellY * game.maze.width + cellX)
+    {
+        game.pendingTurnX = dirX;
+        game.pendingTurnY = dirY;
+        game.pendingTurnTicks = game.turnBufferTicks;
+        return;
+    }
+    game.pendingTurnTicks = 0;
+
+    if (dirX == 0)
+    {
+        // Snapujemy w osi X (wyśrodkowujemy)
+        game.posPlayerX = cellToPos(cellX, PLAYER_WIDTH);
+    }
+    else
+    {
+        // Snapujemy w osi Y
+        game.posPlayerY = cellToPos(cellY, PLAYER_HEIGHT);
+    }
+    game.dirCellX = dirX;
+    game.dirCellY = dirY;
+
+    // Teraz obliczamy docelową komórkę
+    cellX = posToCell(game.posPlayerX, PLAYER_WIDTH);
+    cellY = posToCell(game.posPlayerY, PLAYER_HEIGHT);
+
+    int target = slideTargetOf(game, cellX, cellY, game.dirCellX, game.dirCellY);
+    int tCellX = target % game.maze.width;
+    int tCellY = target / game.maze.width;
+
+    // Zamieniamy na pozycję (też wycentrowaną)
+    game.targetPlayerPosX = cellToPos(tCellX, PLAYER_WIDTH);
+    game.targetPlayerPosY = cellToPos(tCellY, PLAYER_HEIGHT);
+
+    game.isMoving = true;
+}
+
+// Czy ruch z from do to (w jednej osi) minął środek pola center albo na nim stanął
+inline bool passedCenter(fixed_t from, fixed_t to, fixed_t center)
+{
+    if (from == to)
+        return to == center;
+    return from < to ? from < center && center <= to : from > center && center >= to;
+}
+
+// Buforowany skręt: wykonujemy go w tym samym kroku, w którym gracz mija środek
+// pola otwartego w zapamiętanym kierunku (ruch poza środek przepada - to < 2 px)
+inline bool applyBufferedTurn(GameState &game, fixed_t fromX, fixed_t fromY)
+{
+    int cellX = posToCell(game.posPlayerX, PLAYER_WIDTH);
+    int cellY = posToCell(game.posPlayerY, PLAYER_HEIGHT);
+    fixed_t centerX = cellToPos(cellX, PLAYER_WIDTH);
+    fixed_t centerY = cellToPos(cellY, PLAYER_HEIGHT);
+    if (!passedCenter(fromX, game.posPlayerX, centerX) || !passedCenter(fromY, game.posPlayerY, centerY))
+        return false;
+    if (slideTargetOf(game, cellX, cellY, game.pendingTurnX, game.pendingTurnY) == cellY * game.maze.width + cellX)
+        return false;
+
+    game.posPlayerX = centerX;
+    game.posPlayerY = centerY;
+    handleDirectionInput(game, game.pendingTurnX, game.pendingTurnY);
+    return true;
+}
+
+// Pantera dogania gracza (tylko aktywna pantera)
+inline void pantherCatchPlayer(GameState &game, Panther &panther)
+{
+    int checkCellX = posToCell(game.posPlayerX, PLAYER_WIDTH);
+    int checkCellY = posToCell(game.posPlayerY, PLAYER_HEIGHT);
+
+    // Kolizja z panterą
+    if (checkPantherBoxCollision(game.posPlayerX, game.posPlayerY, PLAYER_WIDTH, PLAYER_HEIGHT,
+                                 panther.posX, panther.posY, PANTHER_WIDTH, PANTHER_HEIGHT))
+    {
+        if (!game.justCollidedWithPanther)
+        {
+            recordHeat(game, HEAT_PANTHER_HITS, checkCellX, checkCellY);
+            game.pantherHits++;
+            if (game.hasGold)
+            {
+                game.justCollidedWithPanther = true;
+                panther.isDisabled = true;
+                if (game.verbose)
+                    std::cout << "Złapała Cię pantera. Tracisz złoto!\n";
+                game.hasGold = false;
+            }
+            else
+            {
+                if (game.verbose)
+                    std::cout << "Złapała Cię pantera. Tracisz życie!\n";
+                // Usuwasz jedno życie z labiryntu lub zmniejszasz licznik "lives"
+                setTile(game, 2, 0, TILE_PATH);
+            }
+        }
+        else
+        {
+            // tu "else" jest wobec warunku cellValue == 7
+            // tzn. jeżeli to *nie* pantera, to znaczy, że gracz stoi gdzieś indziej
+            // i można zresetować justCollidedWithPanther
+            game.justCollidedWithPanther = false;
+        }
+    }
+}
+
+// Krok patrolu: prosto, a przy ścianie zawracamy
+inline void movePanther(GameState &game, Panther &panther)
+{
+    const TileGrid &maze = game.maze;
+
+    // Przesunięcie pantery w bieżącym kierunku
+    panther.posX += pantherSpeed * panther.dirX; // Ruch w poziomie
+    panther.posY += pantherSpeed * panther.dirY; // Ruch w pionie
+
+    // Jeśli pantera napotka ścianę, zmień kierunek
+    if (checkPantherCollisionWithWalls(panther.posX, panther.posY, maze))
+    {
+        if (panther.dirX != 0)
+        {                                                // Porusza się w poziomie
+            panther.dirX *= -1;                          // Zmiana kierunku na osi X
+            panther.posX += pantherSpeed * panther.dirX; // Cofnięcie o krok
+        }
+        else if (panther.dirY != 0)
+        {                                                // Porusza się w pionie
+            panther.dirY *= -1;                          // Zmiana kierunku na osi Y
+            panther.posY += pantherSpeed * panther.dirY; // Cofnięcie o krok
+        }
+    }
+}
+
+// Zachowanie pantery: patrol co krok, po zabraniu złota graczowi
+// PANTHER_DISABLE_TIME kroków uśpienia (niegroźna i nieruchoma), potem dalej.
+// Uśpiona pantera nie jest sprawdzana w ogóle - budzi ją koło czasu.
+// Cały stan jest w Panther, a oba co_await są na końcu pętli: po wznowieniu
+// ramka zawsze zaczyna od góry, więc World.h może przywrócić panterę
+// i tylko przestawić ją w kole czasu.
+inline Behaviour pantherBehaviour(Arena &, GameState &game, int index)
+{
+    Panther &panther = game.panthers[index];
+    while (true)
+    {
+        if (panther.isDisabled)
+        {
+            // Wznowienie wyłączonej pantery = koniec uśpienia
+            panther.isDisabled = false;
+            if (game.verbose)
+                std::cout << "[DEBUG] Pantera znowu niebezpieczna.\n";
+        }
+        pantherCatchPlayer(game, panther);
+        movePanther(game, panther);
+        if (panther.isDisabled)
+        {
+            panther.wakeTick = game.behaviours.now + PANTHER_DISABLE_TIME;
+            co_await sleepTicks(game.behaviours, PANTHER_DISABLE_TIME);
+        }
+        else
+        {
+            co_await nextTick(game.behaviours);
+        }
+    }
+}
+
+// Jeden krok symulacji (dawniej: jedna klatka pętli głównej)
+inline void stepSimulation(GameState &game)
+{
+    TileGrid &maze = game.maze;
+    fixed_t fromX = game.posPlayerX;
+    fixed_t fromY = game.posPlayerY;
+
+    // 2) Logika płynnego ruchu
+    if (game.isMoving)
+    {
+        // Cel leży zawsze na tej samej osi (druga jest wyśrodkowana przy
+        // naciśnięciu klawisza), więc odległość to po prostu |dx| + |dy|
+        fixed_t dx = game.targetPlayerPosX - game.posPlayerX;
+        fixed_t dy = game.targetPlayerPosY - game.posPlayerY;
+        fixed_t dist = (dx < 0 ? -dx : dx) + (dy < 0 ? -dy : dy);
+
+        if (dist > speed)
+        {
+            fixed_t stepX = game.posPlayerX + clampStep(dx, speed);
+            fixed_t stepY = game.posPlayerY + clampStep(dy, speed);
+
+            // Sprawdzamy kolizję - wąski korytarz, raczej i tak jej nie będzie,
+            // ale zostawiamy "na wszelki wypadek".
+            if (!checkCollisionWithWalls(stepX, stepY, maze))
+            {
+                game.posPlayerX = stepX;
+                game.posPlayerY = stepY;
+            }
+            else
+            {
+                // Kolizja - zatrzymujemy ruch
+                game.isMoving = false;
+            }
+        }
+        else
+        {
+            // Ostatni krok
+            fixed_t stepX = game.targetPlayerPosX;
+            fixed_t stepY = game.targetPlayerPosY;
+
+            if (!checkCollisionWithWalls(stepX, stepY, maze))
+            {
+                game.posPlayerX = stepX;
+                game.posPlayerY = stepY;
+            }
+            game.isMoving = false;
+        }
+    }
+
+    if (game.pendingTurnTicks > 0)
+    {
+        game.pendingTurnTicks--;
+        applyBufferedTurn(game, fromX, fromY);
+    }
+
+    // 3) Sprawdzamy, czy zbieramy złoto / wejście na start
+    int checkCellX = posToCell(game.posPlayerX, PLAYER_WIDTH);
+    int checkCellY = posToCell(game.posPlayerY, PLAYER_HEIGHT);
+
+    if (checkCellY >= 0 && checkCellY < maze.height &&
+        checkCellX >= 0 && checkCellX < maze.width)
+    {
+        int cellValue = maze.at(checkCellX, checkCellY);
+        const TileInfo &tile = tileInfo(cellValue);
+        if (tile.gold)
+        {
+            // Złoto zatrzymuje gracza; zbieramy tylko z pustymi rękami
+            if (!game.hasGold)
+            {
+                if (game.verbose)
+                    std::cout << tile.pickupMessage;
+                setTile(game, checkCellX, checkCellY, tile.afterPickup);
+                recordHeat(game, HEAT_GOLD_PICKUPS, checkCellX, checkCellY);
+                game.goldPickups++;
+                game.hasGold = true;
+            }
+            game.isMoving = false;
+        }
+        // kolizja ze startem
+        if (checkStartBoxCollision(game.posPlayerX, game.posPlayerY, PLAYER_WIDTH, PLAYER_HEIGHT,
+                                   game.posStartX, game.posStartY, START_WIDTH, START_HEIGHT))
+        {
+            if (game.hasGold)
+            {
+                if (game.verbose)
+                    std::cout << "Oddajesz zloto na start!\n";
+                game.score++;
+                recordHeat(game, HEAT_DELIVERIES, checkCellX, checkCellY);
+                game.hasGold = false;
+            }
+            else
+            {
+                if (game.verbose)
+                    std::cout << "Nie masz złota!\n";
+            }
+        }
+        else if (cellValue == TILE_LIFE)
+        {
+            // Tu np. mechanika życia
+        }
+    }
+
+    // 4) Pantery i inne zachowania, których czas nadszedł
+    game.behaviours.runTick();
+
+    // Gdzie kto spędza czas (na koniec kroku)
+    if (game.heatmap)
+    {
+        recordHeat(game, HEAT_VISITS, checkCellX, checkCellY);
+        for (int p = 0; p < game.pantherCount; ++p)
+            recordHeat(game, HEAT_PANTHER_VISITS,
+                       posToCell(game.panthers[p].posX, PANTHER_WIDTH),
+                       posToCell(game.panthers[p].posY, PANTHER_HEIGHT));
+        game.heatmap->ticks++;
+    }
+}
+
+// Restart poziomu: zwalniamy całą arenę naraz. Wersja planszy rośnie dalej,
+// żeby stare migawki nie uznały swoich kafelków za aktualne.
+template <typename Grid>
+inline bool restartLevel(GameState &game, Arena &arena, const Grid &level)
+{
+    unsigned version = game.tilesVersion;
+    arena.reset();
+    if (!initGameState(game, arena, level))
+        return false;
+    game.tilesVersion = version + 1;
+    return true;
+}
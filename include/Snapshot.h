@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "Simulation.h"
+
+// ----------------- MIGAWKA ŚWIATA DLA RENDEROWANIA ---------
+// Mała, niezmienna po publikacji kopia tego, co trzeba narysować. Wątek
+// symulacji wypełnia ją co krok, wątek renderowania czyta najnowszą
+// (przez TripleBuffer) i nigdy nie dotyka GameState.
+
+// Maksymalny rozmiar planszy w migawce
+const int SNAPSHOT_MAX_WIDTH = 32;
+const int SNAPSHOT_MAX_HEIGHT = 32;
+const int SNAPSHOT_MAX_PANTHERS = 8;
+
+// Który sprite gracza rysować
+enum PlayerFacing : uint8_t
+{
+    FACING_IDLE,
+    FACING_UP,
+    FACING_DOWN,
+    FACING_LEFT,
+    FACING_RIGHT
+};
+
+struct PantherSnapshot
+{
+    int16_t x = 0, y = 0;
+    bool disabled = false;
+};
+
+struct WorldSnapshot
+{
+    uint32_t tick = 0;
+
+    // Pozycje w pikselach (lewy górny róg)
+    int16_t playerX = 0, playerY = 0;
+    uint8_t playerFacing = FACING_IDLE;
+    uint8_t pantherCount = 0;
+    PantherSnapshot panthers[SNAPSHOT_MAX_PANTHERS];
+
+    int32_t score = 0;
+    bool hasGold = false;
+
+    // Znacznik czasu (ms, SDL) ostatniego naciśnięcia strzałki, którego ruch
+    // już widać - render mierzy opóźnienie przy pierwszej klatce z nową wartością
+    uint32_t inputStamp = 0;
+
+    // Kafelki kopiujemy tylko wtedy, gdy ta kopia jest starsza niż plansza
+    uint32_t tilesVersion = ~0u;
+    uint8_t width = 0, height = 0;
+    uint8_t tiles[SNAPSHOT_MAX_HEIGHT][SNAPSHOT_MAX_WIDTH];
+};
+
+inline uint8_t playerFacingOf(const GameState &game)
+{
+    // sprawdzamy, czy gracz idzie w lewo, prawo, górę, dół
+    if (!game.isMoving)
+        return FACING_IDLE;
+    if (game.dirCellX == 1)
+        return FACING_RIGHT;
+    if (game.dirCellX == -1)
+        return FACING_LEFT;
+    if (game.dirCellY == 1)
+        return FACING_DOWN;
+    return FACING_UP;
+}
+
+inline void writeSnapshot(const GameState &game, uint32_t tick, WorldSnapshot &snap)
+{
+    snap.tick = tick;
+    snap.playerX = (int16_t)fixedToInt(game.posPlayerX);
+    snap.playerY = (int16_t)fixedToInt(game.posPlayerY);
+    snap.playerFacing = playerFacingOf(game);
+    int panthers = game.pantherCount;
+    if (panthers > SNAPSHOT_MAX_PANTHERS)
+        panthers = SNAPSHOT_MAX_PANTHERS;
+    for (int p = 0; p < panthers; ++p)
+    {
+        snap.panthers[p].x = (int16_t)fixedToInt(game.panthers[p].posX);
+        snap.panthers[p].y = (int16_t)fixedToInt(game.panthers[p].posY);
+        snap.panthers[p].disabled = game.panthers[p].isDisabled;
+    }
+    snap.pantherCount = (uint8_t)panthers;
+    snap.score = game.score;
+    snap.hasGold = game.hasGold;
+
+    if (snap.tilesVersion != game.tilesVersion)
+    {
+        int h = game.maze.height;
+        if (h > SNAPSHOT_MAX_HEIGHT)
+            h = SNAPSHOT_MAX_HEIGHT;
+        int w = game.maze.width;
+        if (w > SNAPSHOT_MAX_WIDTH)
+            w = SNAPSHOT_MAX_WIDTH;
+        std::memset(snap.tiles, 1, sizeof(snap.tiles));
+        for (int y = 0; y < h; ++y)
+            std::memcpy(snap.tiles[y], &game.maze.tiles[y * game.maze.width], w);
+        snap.width = (uint8_t)w;
+        snap.height = (uint8_t)h;
+        snap.tilesVersion = game.tilesVersion;
+    }
+}
@@ -0,0 +1,532 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "Bitboard.h"
+#include "Maze.h"
+
+// ----------------- SOLVER PLANSZY ---------
+// Sprawdza, czy da się zebrać i oddać całe złoto, używając dokładnie tych
+// reguł ruchu co gra:
+//  - klawisz = ślizg aż do ściany (computeTargetCell),
+//  - bez złota: wejście na 4/3 zabiera jedną sztukę i zatrzymuje gracza
+//    (3 zamienia się w 4),
+//  - ze złotem: każde pole ze złotem zatrzymuje gracza, nic nie zabieramy,
+//  - przejście przez skarbiec (VAULT_CELL) ze złotem = oddanie (+1 punkt),
+//  - nosimy maksymalnie jedną sztukę złota naraz.
+// Pantera jest pomijana - to sprawdzenie samej planszy, nie rozgrywki.
+//
+// W grze klawisz wciśnięty w trakcie ślizgu liczy nowy cel od bieżącego pola,
+// więc skręcić (albo zawrócić) można na każdym polu po drodze. Tryb ścisły
+// (turnWhileMoving = false) pozwala na nowy ruch dopiero po zatrzymaniu -
+// to miara tego, jak "łamigłówkowa" jest plansza.
+
+struct SolverRules
+{
+    bool turnWhileMoving = true;
+};
+
+// Jeden ruch planu (jedno naciśnięcie strzałki)
+struct PlanStep
+{
+    // ruch od (from) w kierunku (dx,dy); (to) to pole zatrzymania albo skrętu
+    int fromX, fromY;
+    int dx, dy;
+    int toX, toY;
+    bool pickedGold; // ruch zakończony podniesieniem złota
+    bool delivered;  // w trakcie ruchu oddano złoto w skarbcu
+};
+
+// Wynik i metryki trudności dla jednej planszy
+struct LevelReport
+{
+    bool solvable = false;
+    bool exact = false;    // true = plan optymalny, false = zachłanny (za dużo złota)
+    std::string failReason;
+
+    int width = 0, height = 0;
+    int openCells = 0;
+    int junctions = 0;     // pola z >= 3 wyjściami
+    int deadEnds = 0;      // pola z 1 wyjściem
+    int goldTiles = 0;     // pola 3/4
+    int goldUnits = 0;     // sztuki złota (3 liczy się podwójnie)
+    int deliveredUnits = 0;
+
+    int moves = 0;         // naciśnięcia strzałek w całym planie
+    int tiles = 0;         // przebyte kafelki w całym planie
+    int longestTripMoves = 0;
+    int longestTripTiles = 0;
+    int searchedStates = 0; // pola odwiedzone przez wszystkie przeszukiwania
+
+    std::vector<PlanStep> plan;
+};
+
+
+// Powyżej tej liczby kombinacji pozostałego złota plan jest zachłanny
+const uint64_t SOLVER_EXACT_GOLD_STATES = 512;
+const uint64_t SOLVER_NO_PATH = ~0ull;
+
+class LevelSolver
+{
+public:
+    explicit LevelSolver(const Maze &maze, SolverRules rules = SolverRules())
+        : maze(maze), rules(rules)
+    {
+        height = (int)maze.size();
+        width = height > 0 ? (int)maze[0].size() : 0;
+        goldIndexAt.assign(width * height, -1);
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < (int)maze[y].size() && x < width; ++x)
+            {
+                const TileInfo &tile = tileInfo(maze[y][x]);
+                if (tile.gold)
+                {
+                    goldIndexAt[cellIndex(x, y)] = (int)gold.size();
+                    GoldTile g = {x, y, tile.goldUnits};
+                    gold.push_back(g);
+                }
+            }
+        }
+    }
+
+    LevelReport solve()
+    {
+        LevelReport report;
+        report.width = width;
+        report.height = height;
+        countTopology(report);
+        for (size_t i = 0; i < gold.size(); ++i)
+            report.goldUnits += gold[i].units;
+        report.goldTiles = (int)gold.size();
+
+        if (!isOpen(START_CELL_X, START_CELL_Y))
+        {
+            report.failReason = "pole startowe jest sciana";
+            return report;
+        }
+        if (!isOpen(VAULT_CELL_X, VAULT_CELL_Y))
+        {
+            report.failReason = "wejscie do skarbca jest sciana";
+            return report;
+        }
+        if (!connectedFromStart(report))
+            return report;
+
+        if (exactPlan(report))
+            return report;
+
+        // Zachłannie (także gdy dokładny nie znalazł planu - żeby wiedzieć,
+        // ile złota w ogóle da się oddać)
+        greedyPlan(report);
+        if (!report.solvable)
+        {
+            report.failReason = "nieosiagalne zloto: " +
+                                std::to_string(report.goldUnits - report.deliveredUnits) + " szt.";
+        }
+        return report;
+    }
+
+private:
+    struct GoldTile
+    {
+        int x, y;
+        int units;
+    };
+
+    // Jeden kurs: pozycja -> złoto -> skarbiec
+    struct Trip
+    {
+        int gold;
+        uint64_t cost;
+        std::vector<PlanStep> steps;
+    };
+
+    // Dijkstra po polach przy stałym stanie złota (jedna faza kursu)
+    struct Search
+    {
+        std::vector<uint64_t> cost;
+        std::vector<int> prevCell;
+        std::vector<PlanStep> prevStep;
+        // zakończenia fazy: podniesienie złota g albo oddanie w skarbcu
+        std::vector<uint64_t> goldCost;
+        std::vector<int> goldPrev;
+        std::vector<PlanStep> goldStep;
+        uint64_t deliverCost;
+        int deliverPrev;
+        PlanStep deliverStep;
+    };
+
+    // Koszt: najpierw czas (kafelki), potem liczba naciśnięć klawiszy
+    static uint64_t moveCost(int tiles)
+    {
+        return ((uint64_t)tiles << 20) + 1;
+    }
+
+    // Ślizg z uwzględnieniem złota i skarbca (jak w pętli gry). Woła emit(pole, kafelki, krok)
+    // dla każdego pola, na którym może zacząć się następny ruch.
+    template <typename Emit>
+    void slide(int cell, int dx, int dy, bool carrying, const std::vector<int> &left, Emit emit) const
+    {
+        int x = cell % width;
+        int y = cell / width;
+        int endX, endY;
+        computeTargetCell(maze, x, y, dx, dy, endX, endY);
+
+        PlanStep step = {x, y, dx, dy, x, y, false, false};
+        int tiles = 0;
+        while (x != endX || y != endY)
+        {
+            x += dx;
+            y += dy;
+            ++tiles;
+            step.toX = x;
+            step.toY = y;
+            if (carrying && x == VAULT_CELL_X && y == VAULT_CELL_Y)
+            {
+                // Skarbiec leży na krawędzi planszy, więc ślizg i tak się na nim kończy
+                step.delivered = true;
+                emit(cellIndex(x, y), tiles, step);
+                return;
+            }
+            int g = goldIndexAt[cellIndex(x, y)];
+            if (g >= 0 && left[g] > 0)
+            {
+                // złoto zatrzymuje gracza; bez złota w ręku - podnosimy
+                step.pickedGold = !carrying;
+                emit(cellIndex(x, y), tiles, step);
+                return;
+            }
+            if (rules.turnWhileMoving || (x == endX && y == endY))
+                emit(cellIndex(x, y), tiles, step);
+        }
+    }
+
+    void search(int startCell, bool carrying, const std::vector<int> &left,
+                Search &s, int &settled) const
+    {
+        static const int DX[4] = {0, 0, -1, 1};
+        static const int DY[4] = {-1, 1, 0, 0};
+
+        s.cost.assign(width * height, SOLVER_NO_PATH);
+        s.prevCell.assign(width * height, -1);
+        s.prevStep.resize(width * height);
+        s.goldCost.assign(gold.size(), SOLVER_NO_PATH);
+        s.goldPrev.assign(gold.size(), -1);
+        s.goldStep.resize(gold.size());
+        s.deliverCost = SOLVER_NO_PATH;
+        s.deliverPrev = -1;
+
+        typedef std::pair<uint64_t, int> QueueItem;
+        std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> open;
+        s.cost[startCell] = 0;
+        open.push(QueueItem(0, startCell));
+
+        while (!open.empty())
+        {
+            QueueItem item = open.top();
+            open.pop();
+            int cell = item.second;
+            if (item.first != s.cost[cell])
+                continue;
+            if (carrying && s.deliverCost <= item.first)
+                break; // lepszego oddania już nie będzie
+            settled++;
+
+            for (int d = 0; d < 4; ++d)
+            {
+                slide(cell, DX[d], DY[d], carrying, left, [&](int to, int tiles, const PlanStep &step)
+                      {
+                    uint64_t c = item.first + moveCost(tiles);
+                    if (step.delivered)
+                    {
+                        if (c < s.deliverCost)
+                        {
+                            s.deliverCost = c;
+                            s.deliverPrev = cell;
+                            s.deliverStep = step;
+                        }
+                    }
+                    else if (step.pickedGold)
+                    {
+                        int g = goldIndexAt[to];
+                        if (c < s.goldCost[g])
+                        {
+                            s.goldCost[g] = c;
+                            s.goldPrev[g] = cell;
+                            s.goldStep[g] = step;
+                        }
+                    }
+                    else if (c < s.cost[to])
+                    {
+                        s.cost[to] = c;
+                        s.prevCell[to] = cell;
+                        s.prevStep[to] = step;
+                        open.push(QueueItem(c, to));
+                    } });
+            }
+        }
+    }
+
+    // Odtworzenie drogi: od startu fazy do pola cell, plus ostatni krok
+    void tracePath(const Search &s, int cell, const PlanStep &last, std::vector<PlanStep> &out) const
+    {
+        size_t first = out.size();
+        out.push_back(last);
+        for (; s.prevCell[cell] >= 0; cell = s.prevCell[cell])
+            out.push_back(s.prevStep[cell]);
+        std::reverse(out.begin() + first, out.end());
+    }
+
+    // Wszystkie możliwe kolejne kursy z danego pola przy danym stanie złota
+    std::vector<Trip> findTrips(int startCell, std::vector<int> &left, int &settled) const
+    {
+        std::vector<Trip> trips;
+        Search toGold, home;
+        search(startCell, false, left, toGold, settled);
+        for (size_t g = 0; g < gold.size(); ++g)
+        {
+            if (toGold.goldCost[g] == SOLVER_NO_PATH)
+                continue;
+            left[g]--;
+            search(cellIndex(gold[g].x, gold[g].y), true, left, home, settled);
+            left[g]++;
+            if (home.deliverCost == SOLVER_NO_PATH)
+                continue;
+
+            Trip trip;
+            trip.gold = (int)g;
+            trip.cost = toGold.goldCost[g] + home.deliverCost;
+            tracePath(toGold, toGold.goldPrev[g], toGold.goldStep[g], trip.steps);
+            tracePath(home, home.deliverPrev, home.deliverStep, trip.steps);
+            trips.push_back(trip);
+        }
+        return trips;
+    }
+
+    // Złoto na polu startowym gra zabiera w pierwszym kroku, zanim padnie
+    // jakikolwiek klawisz - pierwszy kurs zaczyna się wtedy już ze złotem.
+    // Indeks złota na starcie albo -1
+    int startGold() const
+    {
+        return goldIndexAt[cellIndex(START_CELL_X, START_CELL_Y)];
+    }
+
+    // Kurs ze złotem ze startu do skarbca (left już bez zabranej sztuki);
+    // false, gdy ze startu nie da się go oddać
+    bool startTrip(const std::vector<int> &left, Trip &trip, int &settled) const
+    {
+        Search home;
+        search(cellIndex(START_CELL_X, START_CELL_Y), true, left, home, settled);
+        if (home.deliverCost == SOLVER_NO_PATH)
+            return false;
+        trip.gold = startGold();
+        trip.cost = home.deliverCost;
+        tracePath(home, home.deliverPrev, home.deliverStep, trip.steps);
+        return true;
+    }
+
+    // Dokładnie: Dijkstra po stanach złota (system mieszany: ile zostało na każdym polu),
+    // krawędź = jeden kurs. Po pierwszym kursie gracz zawsze stoi w skarbcu.
+    bool exactPlan(LevelReport &report) const
+    {
+        std::vector<uint64_t> weight(gold.size());
+        uint64_t states = 1;
+        for (size_t i = 0; i < gold.size(); ++i)
+        {
+            weight[i] = states;
+            states *= (uint64_t)(gold[i].units + 1);
+            if (states > SOLVER_EXACT_GOLD_STATES)
+                return false;
+        }
+        const uint64_t all = states - 1;
+
+        struct Label
+        {
+            uint64_t cost;
+            uint64_t prev;
+            std::vector<PlanStep> steps;
+        };
+        std::vector<Label> labels(states);
+        for (size_t i = 0; i < labels.size(); ++i)
+            labels[i].cost = SOLVER_NO_PATH;
+
+        std::vector<int> left(gold.size());
+        uint64_t first = all;
+        int g0 = startGold();
+        if (g0 >= 0)
+        {
+            // Pierwszy kurs wymuszony: złoto ze startu do skarbca
+            for (size_t i = 0; i < gold.size(); ++i)
+                left[i] = gold[i].units;
+            left[g0]--;
+            Trip trip;
+            if (!startTrip(left, trip, report.searchedStates))
+                return false;
+            first = all - weight[g0];
+            labels[first].prev = all;
+            labels[first].steps.swap(trip.steps);
+            labels[first].cost = trip.cost;
+        }
+        else
+        {
+            labels[all].cost = 0;
+        }
+
+        typedef std::pair<uint64_t, uint64_t> QueueItem;
+        std::priority_queue<QueueItem, std::vector<QueueItem>, std::greater<QueueItem>> open;
+        open.push(QueueItem(labels[first].cost, first));
+        while (!open.empty())
+        {
+            QueueItem item = open.top();
+            open.pop();
+            uint64_t r = item.second;
+            if (item.first != labels[r].cost)
+                continue;
+            if (r == 0)
+                break;
+            for (size_t i = 0; i < gold.size(); ++i)
+                left[i] = (int)((r / weight[i]) % (uint64_t)(gold[i].units + 1));
+            int start = (r == all) ? cellIndex(START_CELL_X, START_CELL_Y)
+                                   : cellIndex(VAULT_CELL_X, VAULT_CELL_Y);
+            std::vector<Trip> trips = findTrips(start, left, report.searchedStates);
+            for (size_t t = 0; t < trips.size(); ++t)
+            {
+                uint64_t next = r - weight[trips[t].gold];
+                uint64_t c = item.first + trips[t].cost;
+                if (c < labels[next].cost)
+                {
+                    labels[next].cost = c;
+                    labels[next].prev = r;
+                    labels[next].steps.swap(trips[t].steps);
+                    open.push(QueueItem(c, next));
+                }
+            }
+        }
+        if (labels[0].cost == SOLVER_NO_PATH)
+            return false;
+
+        std::vector<uint64_t> chain;
+        for (uint64_t r = 0; r != all; r = labels[r].prev)
+            chain.push_back(r);
+        for (size_t i = chain.size(); i-- > 0;)
+            appendPlan(report, labels[chain[i]].steps);
+        report.deliveredUnits = report.goldUnits;
+        report.solvable = true;
+        report.exact = true;
+        return true;
+    }
+
+    // Zachłannie: zawsze najtańszy kolejny kurs
+    void greedyPlan(LevelReport &report) const
+    {
+        std::vector<int> left(gold.size());
+        for (size_t i = 0; i < gold.size(); ++i)
+            left[i] = gold[i].units;
+        int cell = cellIndex(START_CELL_X, START_CELL_Y);
+        int g0 = startGold();
+        if (g0 >= 0)
+        {
+            left[g0]--;
+            Trip trip;
+            if (!startTrip(left, trip, report.searchedStates))
+                return;
+            appendPlan(report, trip.steps);
+            cell = cellIndex(VAULT_CELL_X, VAULT_CELL_Y);
+            report.deliveredUnits++;
+        }
+        while (report.deliveredUnits < report.goldUnits)
+        {
+            std::vector<Trip> trips = findTrips(cell, left, report.searchedStates);
+            if (trips.empty())
+                break;
+            size_t best = 0;
+            for (size_t t = 1; t < trips.size(); ++t)
+                if (trips[t].cost < trips[best].cost)
+                    best = t;
+            appendPlan(report, trips[best].steps);
+            left[trips[best].gold]--;
+            cell = cellIndex(VAULT_CELL_X, VAULT_CELL_Y);
+            report.deliveredUnits++;
+        }
+        report.solvable = (report.deliveredUnits == report.goldUnits);
+    }
+
+    void appendPlan(LevelReport &report, const std::vector<PlanStep> &steps) const
+    {
+        int tripMoves = 0, tripTiles = 0;
+        for (size_t i = 0; i < steps.size(); ++i)
+        {
+            const PlanStep &s = steps[i];
+            int len = std::abs(s.toX - s.fromX) + std::abs(s.toY - s.fromY);
+            report.plan.push_back(s);
+            report.moves++;
+            report.tiles += len;
+            tripMoves++;
+            tripTiles += len;
+        }
+        report.longestTripMoves = std::max(report.longestTripMoves, tripMoves);
+        report.longestTripTiles = std::max(report.longestTripTiles, tripTiles);
+    }
+
+    // Szybkie odrzucenie na bitboardzie: złota odciętego ścianami od startu
+    // nie zbierze żaden ruch, więc nie ma po co uruchamiać przeszukiwań
+    bool connectedFromStart(LevelReport &report) const
+    {
+        MazeBitboard open, reached, cutOff;
+        buildOpenMask(maze, open);
+        floodFillFrom(open, START_CELL_X, START_CELL_Y, reached);
+        if (!reached.test(VAULT_CELL_X, VAULT_CELL_Y))
+        {
+            report.failReason = "skarbiec odciety od startu";
+            return false;
+        }
+        buildGoldMask(maze, cutOff);
+        cutOff.andNot(reached);
+        if (!cutOff.empty())
+        {
+            report.failReason = "zloto odciete od startu: " + std::to_string(cutOff.count()) + " pol";
+            return false;
+        }
+        return true;
+    }
+
+    void countTopology(LevelReport &report) const
+    {
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                if (!isOpen(x, y))
+                    continue;
+                int exits = isOpen(x - 1, y) + isOpen(x + 1, y) + isOpen(x, y - 1) + isOpen(x, y + 1);
+                report.openCells++;
+                if (exits >= 3)
+                    report.junctions++;
+                else if (exits == 1)
+                    report.deadEnds++;
+            }
+        }
+    }
+
+    bool isOpen(int x, int y) const
+    {
+        if (y < 0 || y >= height || x < 0 || x >= (int)maze[y].size())
+            return false;
+        return !isSolidTile(maze[y][x]);
+    }
+
+    int cellIndex(int x, int y) const { return y * width + x; }
+
+    const Maze &maze;
+    SolverRules rules;
+    int width, height;
+    std::vector<GoldTile> gold;
+    std::vector<int> goldIndexAt; // indeks złota na polu albo -1
+};
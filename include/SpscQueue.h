@@ -0,0 +1,39 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+// ----------------- KOLEJKA JEDEN PRODUCENT / JEDEN KONSUMENT ---------
+// Bufor cykliczny bez blokad: wątek zdarzeń SDL wkłada polecenia gracza,
+// wątek symulacji je wyjmuje. Gdy kolejka jest pełna, push zwraca false.
+template <typename T, size_t Capacity>
+class SpscQueue
+{
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity musi byc potega dwojki");
+
+public:
+    bool push(const T &item)
+    {
+        size_t head = headIndex.load(std::memory_order_relaxed);
+        if (head - tailIndex.load(std::memory_order_acquire) == Capacity)
+            return false;
+        items[head & (Capacity - 1)] = item;
+        headIndex.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T &item)
+    {
+        size_t tail = tailIndex.load(std::memory_order_relaxed);
+        if (tail == headIndex.load(std::memory_order_acquire))
+            return false;
+        item = items[tail & (Capacity - 1)];
+        tailIndex.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    T items[Capacity];
+    alignas(64) std::atomic<size_t> headIndex{0};
+    alignas(64) std::atomic<size_t> tailIndex{0};
+};
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstdint>
+
+// ----------------- TYPY KAFELKÓW ---------
+// Wszystko, co gra wie o danej wartości w labiryncie, w jednej tabeli
+// liczonej w czasie kompilacji. Logika i rysowanie pytają tabelę
+// (TILE_TABLE.info[wartość]) zamiast porównywać liczby w łańcuchach if/else,
+// więc nowy typ kafelka to nowy wpis w makeTileInfo.
+
+// Wartości w plikach plansz (1=ściana, 0=ścieżka, 5=życie, 4 - złoto, 3 - złoto podwójne)
+enum TileType : uint8_t
+{
+    TILE_PATH = 0,
+    TILE_WALL = 1,
+    TILE_GOLD2 = 3,
+    TILE_GOLD = 4,
+    TILE_LIFE = 5
+};
+
+// Jak rysować kafelek
+enum TileLayer : uint8_t
+{
+    TILE_LAYER_BACKGROUND, // pełny kwadrat w kolorze kafelka
+    TILE_LAYER_SPRITE      // sprite 8x8 w kolorze kafelka na tle ścieżki
+};
+
+// Który sprite (gra mapuje to na tablice z Sprites.h)
+enum TileSprite : uint8_t
+{
+    TILE_SPRITE_NONE,
+    TILE_SPRITE_GOLD,
+    TILE_SPRITE_GOLD2,
+    TILE_SPRITE_COUNT
+};
+
+struct TileColor
+{
+    uint8_t r, g, b, a;
+};
+
+struct TileInfo
+{
+    bool solid = false;     // ściana dla gracza, pantery i ślizgu
+    bool gold = false;      // wejście na kafelek zbiera złoto (i zatrzymuje gracza)
+    uint8_t afterPickup = TILE_PATH; // czym kafelek staje się po zebraniu
+    uint8_t goldUnits = 0;  // ile razy można tu zebrać złoto
+    uint8_t layer = TILE_LAYER_BACKGROUND;
+    uint8_t sprite = TILE_SPRITE_NONE;
+    TileColor color = {0, 0, 0, 255};
+    const char *pickupMessage = nullptr;
+};
+
+constexpr TileInfo makeTileInfo(int type)
+{
+    TileInfo t;
+    switch (type)
+    {
+    case TILE_WALL:
+        t.solid = true;
+        t.color = {0, 0, 255, 255}; // Niebieski
+        break;
+    case TILE_GOLD:
+        t.gold = true;
+        t.afterPickup = TILE_PATH;
+        t.layer = TILE_LAYER_SPRITE;
+        t.sprite = TILE_SPRITE_GOLD;
+        t.color = {255, 215, 0, 255}; // Złoty
+        t.pickupMessage = "Zbierasz zloto pojedyncze\n";
+        break;
+    case TILE_GOLD2:
+        t.gold = true;
+        t.afterPickup = TILE_GOLD; // podwójne złoto zostawia pojedyncze
+        t.layer = TILE_LAYER_SPRITE;
+        t.sprite = TILE_SPRITE_GOLD2;
+        t.color = {255, 115, 66, 255}; // Złoto "podwójne"
+        t.pickupMessage = "Zbierasz zloto podwojne\n";
+        break;
+    case TILE_LIFE:
+        t.color = {255, 0, 0, 255}; // Czerwony
+        break;
+    default: // ścieżka i nieznane wartości
+        t.color = {0, 0, 0, 255};
+        break;
+    }
+    return t;
+}
+
+struct TileTable
+{
+    TileInfo info[256];
+};
+
+constexpr TileTable buildTileTable()
+{
+    TileTable table;
+    for (int i = 0; i < 256; ++i)
+        table.info[i] = makeTileInfo(i);
+    // Ile złota leży na kafelku: łańcuch afterPickup aż do kafelka bez złota
+    for (int i = 0; i < 256; ++i)
+    {
+        int units = 0;
+        for (int v = i; table.info[v].gold && units < 255; v = table.info[v].afterPickup)
+            units++;
+        table.info[i].goldUnits = (uint8_t)units;
+    }
+    return table;
+}
+
+inline constexpr TileTable TILE_TABLE = buildTileTable();
+
+// Indeks to uint8_t, więc każda wartość ma wpis - bez sprawdzania zakresu
+inline const TileInfo &tileInfo(int value)
+{
+    return TILE_TABLE.info[(uint8_t)value];
+}
+
+inline bool isSolidTile(int value)
+{
+    return TILE_TABLE.info[(uint8_t)value].solid;
+}
+
+static_assert(TILE_TABLE.info[TILE_WALL].solid && !TILE_TABLE.info[TILE_PATH].solid, "sciana/sciezka");
+static_assert(TILE_TABLE.info[TILE_GOLD].goldUnits == 1 && TILE_TABLE.info[TILE_GOLD2].goldUnits == 2,
+              "zloto podwojne to dwa zebrania");
+static_assert(!TILE_TABLE.info[TILE_TABLE.info[TILE_GOLD].afterPickup].gold, "zloto musi sie skonczyc");
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// ----------------- POTRÓJNY BUFOR (bez blokad) ---------
+// Jeden pisarz (wątek symulacji) i jeden czytelnik (wątek renderowania).
+// Pisarz zawsze ma wolny bufor do zapisu, czytelnik zawsze dostaje najnowszy
+// opublikowany - żaden z nich nigdy nie czeka na drugiego. Pośrednie wersje,
+// których czytelnik nie zdążył odebrać, są po prostu pomijane.
+template <typename T>
+class TripleBuffer
+{
+public:
+    // Bufor, do którego pisze wątek symulacji
+    T &writeBuffer()
+    {
+        return buffers[backIndex];
+    }
+
+    // Publikacja zapisanego bufora (zamiana z buforem środkowym)
+    void publish()
+    {
+        uint8_t previous = middle.exchange(backIndex | FRESH, std::memory_order_acq_rel);
+        backIndex = previous & INDEX_MASK;
+    }
+
+    // Najnowszy opublikowany bufor; isNew = czy to coś nowego od ostatniego odczytu
+    const T &readNewest(bool *isNew = nullptr)
+    {
+        bool fresh = (middle.load(std::memory_order_relaxed) & FRESH) != 0;
+        if (fresh)
+        {
+            uint8_t previous = middle.exchange(frontIndex, std::memory_order_acq_rel);
+            frontIndex = previous & INDEX_MASK;
+        }
+        if (isNew)
+            *isNew = fresh;
+        return buffers[frontIndex];
+    }
+
+private:
+    static const uint8_t INDEX_MASK = 0x3;
+    static const uint8_t FRESH = 0x4;
+
+    T buffers[3];
+    uint8_t backIndex = 0;                    // tylko pisarz
+    alignas(64) std::atomic<uint8_t> middle{1};
+    alignas(64) uint8_t frontIndex = 2;       // tylko czytelnik
+};
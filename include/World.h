@@ -0,0 +1,273 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "Simulation.h"
+
+// ----------------- ZAPIS I PRZYWRACANIE ŚWIATA ---------
+// WorldSave to cały zmienny stan poziomu w jednej płaskiej strukturze bez
+// wskaźników: gracz, pantery (z krokiem budzenia), licznik kroków i tabela
+// stron kafelków. Kopia zapisu to memcpy ~2 KB, niezależnie od planszy.
+//
+// Kafelki są w stronach po TILE_PAGE_SIZE pól w TilePagePool i są
+// współdzielone (copy-on-write): zapis kopiuje do puli tylko strony
+// zmienione przez setTile od poprzedniego zapisu, a przywrócenie - tylko
+// te, które różnią się od stanu w GameState. Zwykle to zero lub jedna
+// strona, więc "przywróć, zasymuluj N kroków, oceń" można powtarzać
+// tysiące razy na klatkę (bot z wyprzedzeniem, cofanie czasu).
+//
+// Pula tylko rośnie; gdy się zapełni, saveWorld zwraca false - wołający
+// robi pool.reset() + forgetTilePages(game) i wyrzuca swoje stare zapisy.
+// Pola należące do wołającego (heatmap, verbose) i tilesVersion nie są
+// częścią zapisu.
+
+const int WORLD_MAX_PANTHERS = 8;
+
+// Plansza ma najwyżej 0xFFFF pól (tabela ślizgów), stąd liczba stron
+const int WORLD_MAX_PAGES = (0xFFFF + TILE_PAGE_SIZE - 1) / TILE_PAGE_SIZE;
+
+struct PantherSave
+{
+    fixed_t posX, posY;
+    int8_t dirX, dirY;
+    bool isDisabled;
+    uint32_t wakeTick;
+};
+
+struct WorldSave
+{
+    uint32_t tick; // behaviours.now
+    uint16_t width, height;
+
+    fixed_t posPlayerX, posPlayerY;
+    fixed_t targetPlayerPosX, targetPlayerPosY;
+    int8_t dirCellX, dirCellY;
+    int8_t pendingTurnX, pendingTurnY;
+    uint8_t pendingTurnTicks;
+    bool isMoving;
+    bool hasGold;
+    bool justCollidedWithPanther;
+    int32_t score;
+    int32_t goldPickups, pantherHits;
+
+    uint8_t pantherCount;
+    PantherSave panthers[WORLD_MAX_PANTHERS];
+
+    uint16_t pageCount;
+    uint16_t pages[WORLD_MAX_PAGES]; // strony w TilePagePool
+};
+
+static_assert(std::is_trivially_copyable<WorldSave>::value, "zapis swiata kopiujemy memcpy");
+
+class TilePagePool
+{
+public:
+    explicit TilePagePool(int capacityPages = 4096)
+        : data((size_t)capacityPages * TILE_PAGE_SIZE), capacity(capacityPages)
+    {
+        if (capacity > TILE_PAGE_DIRTY)
+            capacity = TILE_PAGE_DIRTY;
+    }
+
+    // Numer nowej strony albo TILE_PAGE_DIRTY, gdy pula jest pełna
+    uint16_t allocate()
+    {
+        return used < capacity ? (uint16_t)used++ : TILE_PAGE_DIRTY;
+    }
+
+    uint8_t *page(uint16_t index) { return &data[(size_t)index * TILE_PAGE_SIZE]; }
+    const uint8_t *page(uint16_t index) const { return &data[(size_t)index * TILE_PAGE_SIZE]; }
+
+    void reset() { used = 0; }
+    int pagesUsed() const { return used; }
+
+private:
+    std::vector<uint8_t> data;
+    int capacity;
+    int used = 0;
+};
+
+// Po pool.reset(): żadna strona GameState nie ma już kopii w puli
+inline void forgetTilePages(GameState &game)
+{
+    for (int p = 0; p < game.tilePageCount; ++p)
+        game.tilePages[p] = TILE_PAGE_DIRTY;
+}
+
+inline int tilePageBytes(const GameState &game, int page)
+{
+    int cells = game.maze.width * game.maze.height;
+    int left = cells - page * TILE_PAGE_SIZE;
+    return left < TILE_PAGE_SIZE ? left : TILE_PAGE_SIZE;
+}
+
+// Zapis między krokami symulacji; false, gdy pula jest pełna albo poziom
+// ma więcej panter niż WORLD_MAX_PANTHERS
+inline bool saveWorld(GameState &game, WorldSave &save, TilePagePool &pool)
+{
+    if (game.pantherCount > WORLD_MAX_PANTHERS)
+        return false;
+
+    // Najpierw strony - przy pełnej puli zapis nie powstaje wcale
+    for (int p = 0; p < game.tilePageCount; ++p)
+    {
+        if (game.tilePages[p] != TILE_PAGE_DIRTY)
+            continue;
+        uint16_t index = pool.allocate();
+        if (index == TILE_PAGE_DIRTY)
+            return false;
+        std::memcpy(pool.page(index), game.maze.tiles + p * TILE_PAGE_SIZE, tilePageBytes(game, p));
+        game.tilePages[p] = index;
+    }
+    save.pageCount = (uint16_t)game.tilePageCount;
+    std::memcpy(save.pages, game.tilePages, game.tilePageCount * sizeof(uint16_t));
+
+    save.tick = game.behaviours.now;
+    save.width = (uint16_t)game.maze.width;
+    save.height = (uint16_t)game.maze.height;
+    save.posPlayerX = game.posPlayerX;
+    save.posPlayerY = game.posPlayerY;
+    save.targetPlayerPosX = game.targetPlayerPosX;
+    save.targetPlayerPosY = game.targetPlayerPosY;
+    save.dirCellX = (int8_t)game.dirCellX;
+    save.dirCellY = (int8_t)game.dirCellY;
+    save.pendingTurnX = (int8_t)game.pendingTurnX;
+    save.pendingTurnY = (int8_t)game.pendingTurnY;
+    save.pendingTurnTicks = (uint8_t)game.pendingTurnTicks;
+    save.isMoving = game.isMoving;
+    save.hasGold = game.hasGold;
+    save.justCollidedWithPanther = game.justCollidedWithPanther;
+    save.score = game.score;
+    save.goldPickups = game.goldPickups;
+    save.pantherHits = game.pantherHits;
+
+    save.pantherCount = (uint8_t)game.pantherCount;
+    for (int i = 0; i < game.pantherCount; ++i)
+    {
+        const Panther &src = game.panthers[i];
+        PantherSave &dst = save.panthers[i];
+        dst.posX = src.posX;
+        dst.posY = src.posY;
+        dst.dirX = (int8_t)src.dirX;
+        dst.dirY = (int8_t)src.dirY;
+        dst.isDisabled = src.isDisabled;
+        dst.wakeTick = src.wakeTick;
+    }
+    return true;
+}
+
+// Przywrócenie zapisu z tego samego poziomu (te same wymiary i pantery,
+// także po restarcie). Zachowania panter zostają te same - tylko koło czasu
+// jest układane od nowa z kroków budzenia w zapisie.
+inline bool restoreWorld(GameState &game, const WorldSave &save, const TilePagePool &pool)
+{
+    if (save.width != game.maze.width || save.height != game.maze.height ||
+        save.pantherCount != game.pantherCount)
+        return false;
+
+    bool tilesChanged = false;
+    for (int p = 0; p < save.pageCount; ++p)
+    {
+        if (game.tilePages[p] == save.pages[p])
+            continue;
+        std::memcpy(game.maze.tiles + p * TILE_PAGE_SIZE, pool.page(save.pages[p]), tilePageBytes(game, p));
+        game.tilePages[p] = save.pages[p];
+        tilesChanged = true;
+    }
+    if (tilesChanged)
+        game.tilesVersion++;
+
+    game.posPlayerX = save.posPlayerX;
+    game.posPlayerY = save.posPlayerY;
+    game.targetPlayerPosX = save.targetPlayerPosX;
+    game.targetPlayerPosY = save.targetPlayerPosY;
+    game.dirCellX = save.dirCellX;
+    game.dirCellY = save.dirCellY;
+    game.pendingTurnX = save.pendingTurnX;
+    game.pendingTurnY = save.pendingTurnY;
+    game.pendingTurnTicks = save.pendingTurnTicks;
+    game.isMoving = save.isMoving;
+    game.hasGold = save.hasGold;
+    game.justCollidedWithPanther = save.justCollidedWithPanther;
+    game.score = save.score;
+    game.goldPickups = save.goldPickups;
+    game.pantherHits = save.pantherHits;
+
+    game.behaviours.clear(save.tick);
+    for (int i = 0; i < save.pantherCount; ++i)
+    {
+        Panther &dst = game.panthers[i];
+        const PantherSave &src = save.panthers[i];
+        dst.posX = src.posX;
+        dst.posY = src.posY;
+        dst.dirX = src.dirX;
+        dst.dirY = src.dirY;
+        dst.isDisabled = src.isDisabled;
+        dst.wakeTick = src.wakeTick;
+        // Aktywna pantera działa w najbliższym kroku, wyłączona śpi do wakeTick
+        game.behaviours.schedule(dst.behaviour, dst.isDisabled ? dst.wakeTick - save.tick : 0);
+    }
+    return true;
+}
+
+// ----------------- COFANIE CZASU ---------
+// Pierścień zapisów co WORLD_HISTORY_INTERVAL kroków; rollback(n) wraca
+// o n zapisów (nowsze przepadają - to teraz "przyszłość").
+const int WORLD_HISTORY_SIZE = 16;
+const int WORLD_HISTORY_INTERVAL = SIM_TICK_RATE;
+
+class WorldHistory
+{
+public:
+    // Też po restarcie poziomu (stare zapisy nie pasują do nowej areny)
+    void clear(GameState &game)
+    {
+        count = 0;
+        head = 0;
+        pool.reset();
+        forgetTilePages(game);
+    }
+
+    // Wołane po każdym kroku; zapisuje co WORLD_HISTORY_INTERVAL kroków
+    void record(GameState &game)
+    {
+        if (game.behaviours.now % WORLD_HISTORY_INTERVAL != 0)
+            return;
+        WorldSave &slot = saves[head];
+        if (!saveWorld(game, slot, pool))
+        {
+            // Pula pełna: historia od nowa, zaczynając od tej chwili
+            clear(game);
+            if (!saveWorld(game, slot, pool))
+                return;
+        }
+        head = (head + 1) % WORLD_HISTORY_SIZE;
+        if (count < WORLD_HISTORY_SIZE)
+            count++;
+    }
+
+    // Powrót o steps zapisów wstecz (1 = ostatni); false, gdy historia za krótka
+    bool rollback(GameState &game, int steps)
+    {
+        if (steps < 1 || steps > count)
+            return false;
+        int index = (head - steps + WORLD_HISTORY_SIZE) % WORLD_HISTORY_SIZE;
+        if (!restoreWorld(game, saves[index], pool))
+            return false;
+        // Przywrócony zapis zostaje w historii jako najnowszy
+        head = (index + 1) % WORLD_HISTORY_SIZE;
+        count -= steps - 1;
+        return true;
+    }
+
+    int size() const { return count; }
+
+private:
+    WorldSave saves[WORLD_HISTORY_SIZE];
+    int count = 0;
+    int head = 0;
+    TilePagePool pool;
+};
@@ -0,0 +1,144 @@
+// Paczka plansz dla gry (include/LevelPack.h).
+//
+//   level_pack -o plansze.pack plik.txt [...] [-g N] [-s ZIARNO] [-w SZER] [-h WYS]
+//                                 - buduje paczkę z plików (format jak mazeGen.txt)
+//                                   i N plansz z generatora; solver liczy złoto
+//                                   i trudność do indeksu
+//   level_pack -l plansze.pack    - lista plansz z samego indeksu
+//   level_pack -x plansze.pack N  - plansza N (od 0) na stdout w formacie plików
+//
+// Wygenerowana plansza "gen-S" to ta sama plansza co wiersz S w raporcie
+// level_solver -s ... (to samo ziarno i ten sam strumień generatora).
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "include/LevelPack.h"
+#include "include/Maze.h"
+#include "include/MazeGen.h"
+#include "include/Random.h"
+#include "include/Solver.h"
+
+bool addLevel(LevelPackWriter &writer, const std::string &name, const Maze &maze)
+{
+    LevelSolver solver(maze, SolverRules());
+    LevelReport r = solver.solve();
+    if (!writer.add(name, maze, r.goldUnits, r.solvable ? r.moves : 0))
+    {
+        std::cerr << "Level does not fit the pack format: " << name << std::endl;
+        return false;
+    }
+    if (!r.solvable)
+        std::cerr << "Uwaga: " << name << " nie do przejscia (" << r.failReason << ")\n";
+    return true;
+}
+
+int listPack(const char *path)
+{
+    LevelPack pack;
+    if (!pack.open(path))
+        return 1;
+    std::cout << "nr,name,width,height,gold_units,solver_moves,difficulty,packed_bytes\n";
+    for (int i = 0; i < pack.size(); ++i)
+    {
+        const LevelPackEntry &e = pack.entry(i);
+        std::cout << i << ',' << e.name << ',' << e.width << ',' << e.height << ','
+                  << e.goldUnits << ',' << e.solverMoves << ',' << (int)e.difficulty << ','
+                  << e.packedBytes << '\n';
+    }
+    return 0;
+}
+
+int extractLevel(const char *path, int index)
+{
+    LevelPack pack;
+    if (!pack.open(path))
+        return 1;
+    const TileGrid *grid = pack.level(index);
+    if (!grid)
+    {
+        std::cerr << "No level " << index << " in " << path << std::endl;
+        return 1;
+    }
+    for (int y = 0; y < grid->height; ++y)
+    {
+        std::cout << '{';
+        for (int x = 0; x < grid->width; ++x)
+            std::cout << (x ? "," : "") << (int)grid->at(x, y);
+        std::cout << "},\n";
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *output = nullptr;
+    int generated = 0;
+    uint64_t seed = 1;
+    int width = 22, height = 24;
+    std::vector<const char *> files;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const char *a = argv[i];
+        if (!std::strcmp(a, "-l") && i + 1 < argc)
+            return listPack(argv[i + 1]);
+        else if (!std::strcmp(a, "-x") && i + 2 < argc)
+            return extractLevel(argv[i + 1], std::atoi(argv[i + 2]));
+        else if (!std::strcmp(a, "-o") && i + 1 < argc)
+            output = argv[++i];
+        else if (!std::strcmp(a, "-g") && i + 1 < argc)
+            generated = std::atoi(argv[++i]);
+        else if (!std::strcmp(a, "-s") && i + 1 < argc)
+            seed = std::strtoull(argv[++i], NULL, 10);
+        else if (!std::strcmp(a, "-w") && i + 1 < argc)
+            width = std::atoi(argv[++i]);
+        else if (!std::strcmp(a, "-h") && i + 1 < argc)
+            height = std::atoi(argv[++i]);
+        else
+            files.push_back(a);
+    }
+    if (!output || (files.empty() && generated <= 0))
+    {
+        std::cerr << "Uzycie: level_pack -o PACZKA plik.txt [...] [-g LICZBA] [-s ZIARNO] [-w SZER] [-h WYS]\n"
+                     "       level_pack -l PACZKA\n"
+                     "       level_pack -x PACZKA NR\n";
+        return 1;
+    }
+
+    LevelPackWriter writer;
+    for (size_t f = 0; f < files.size(); ++f)
+    {
+        Maze maze;
+        if (!loadMazeFile(files[f], maze))
+        {
+            std::cerr << "Cannot load level: " << files[f] << std::endl;
+            return 1;
+        }
+        // W indeksie sama nazwa pliku, bez katalogu
+        std::string name = files[f];
+        size_t slash = name.find_last_of('/');
+        if (slash != std::string::npos)
+            name = name.substr(slash + 1);
+        if (!addLevel(writer, name, maze))
+            return 1;
+    }
+    for (int n = 0; n < generated; ++n)
+    {
+        Rng rng(rngStreamSeed(seed + n, RNG_MAZE_GEN, 0));
+        Maze maze = generateMaze(width, height, rng);
+        if (!addLevel(writer, "gen-" + std::to_string(seed + n), maze))
+            return 1;
+    }
+
+    if (!writer.write(output))
+        return 1;
+    std::cerr << "Paczka " << output << ": " << writer.size() << " plansz, dane "
+              << writer.payloadBytes() << " B (" << (double)writer.payloadBytes() / writer.size()
+              << " B na plansze)\n";
+    return 0;
+}
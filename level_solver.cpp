@@ -0,0 +1,264 @@
+// Solver i walidator plansz Raid on Fort Knox.
+//
+//   level_solver plik.txt [...]       - sprawdza plansze z plików (format jak mazeGen.txt)
+//                                       i wypisuje plan zebrania złota
+//   level_solver -n 10000 [-j N] [-s ZIARNO] [-w SZER] [-h WYS]
+//                                     - generuje N plansz natywnym generatorem
+//                                       i sprawdza je na wszystkich rdzeniach
+//   level_solver --large plik.txt     - plansza za duża na plan (miliony kafelków):
+//                                       wczytana pasami do ChunkedMaze, sprawdza tylko,
+//                                       czy skarbiec i każde złoto są osiągalne ze startu
+//   --strict                          - ruch tylko po zatrzymaniu na ścianie/złocie
+//                                       (bez skrętów w trakcie ślizgu)
+//
+// Wynik wsadowy to CSV (jedna linia na planszę) + podsumowanie na stderr.
+// Plansza z kolumny seed powtarza się przez -s SEED -n 1.
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "include/ChunkedMaze.h"
+#include "include/Maze.h"
+#include "include/MazeGen.h"
+#include "include/Random.h"
+#include "include/Solver.h"
+
+const char *directionName(int dx, int dy)
+{
+    if (dx == 1)
+        return "prawo";
+    if (dx == -1)
+        return "lewo";
+    if (dy == 1)
+        return "dol";
+    return "gora";
+}
+
+void printCsvHeader()
+{
+    std::cout << "level,width,height,solvable,exact,gold_tiles,gold_units,delivered,"
+                 "moves,tiles,longest_trip_moves,longest_trip_tiles,open_cells,"
+                 "junctions,dead_ends,states,fail_reason\n";
+}
+
+void printCsvLine(const std::string &name, const LevelReport &r)
+{
+    std::cout << name << ',' << r.width << ',' << r.height << ','
+              << r.solvable << ',' << r.exact << ','
+              << r.goldTiles << ',' << r.goldUnits << ',' << r.deliveredUnits << ','
+              << r.moves << ',' << r.tiles << ','
+              << r.longestTripMoves << ',' << r.longestTripTiles << ','
+              << r.openCells << ',' << r.junctions << ',' << r.deadEnds << ','
+              << r.searchedStates << ',' << r.failReason << '\n';
+}
+
+int solveFiles(int argc, char *argv[], int first, SolverRules rules)
+{
+    int failures = 0;
+    for (int i = first; i < argc; ++i)
+    {
+        Maze maze;
+        if (!loadMazeFile(argv[i], maze))
+        {
+            std::cerr << "Nie mozna wczytac planszy: " << argv[i] << std::endl;
+            failures++;
+            continue;
+        }
+        LevelSolver solver(maze, rules);
+        LevelReport r = solver.solve();
+
+        std::cout << argv[i] << ": " << (r.solvable ? "do przejscia" : "NIE do przejscia");
+        if (!r.solvable)
+            std::cout << " (" << r.failReason << ")";
+        std::cout << "\n  zloto: " << r.goldUnits << " szt. na " << r.goldTiles << " polach"
+                  << ", ruchy: " << r.moves << ", kafelki: " << r.tiles
+                  << (r.exact ? " (plan optymalny)" : " (plan zachlanny)") << "\n";
+        for (size_t s = 0; s < r.plan.size(); ++s)
+        {
+            const PlanStep &p = r.plan[s];
+            std::cout << "  " << s + 1 << ". (" << p.fromX << "," << p.fromY << ") "
+                      << directionName(p.dx, p.dy) << " -> (" << p.toX << "," << p.toY << ")";
+            if (p.pickedGold)
+                std::cout << " [zloto]";
+            if (p.delivered)
+                std::cout << " [oddane]";
+            std::cout << "\n";
+        }
+        if (!r.solvable)
+            failures++;
+    }
+    return failures ? 1 : 0;
+}
+
+// Duża plansza: bez pełnego planu (solver trzyma planszę w Maze i szuka po
+// stanach złota), tylko osiągalność pieszo ze startu - skarbca i każdego pola
+// ze złotem. Wypełnianie idzie po kafelkach ChunkedMaze, więc pamięć to
+// spakowana plansza i bajt odwiedzin na pole.
+int checkLargeLevel(const char *path)
+{
+    ChunkedMaze maze;
+    if (!loadChunkedMazeFile(path, maze))
+    {
+        std::cerr << "Nie mozna wczytac planszy: " << path << std::endl;
+        return 1;
+    }
+    int w = maze.getWidth(), h = maze.getHeight();
+    if (w <= START_CELL_X || h <= START_CELL_Y || isSolidTile(maze.get(START_CELL_X, START_CELL_Y)))
+    {
+        std::cerr << "Plansza bez otwartego pola startowego: " << path << std::endl;
+        return 1;
+    }
+    auto start = std::chrono::steady_clock::now();
+
+    static const int DX[4] = {0, 0, -1, 1};
+    static const int DY[4] = {-1, 1, 0, 0};
+    std::vector<uint8_t> reached((size_t)w * h, 0);
+    // Numery pól w size_t - plansza może mieć więcej niż INT_MAX pól
+    std::vector<size_t> stack;
+    stack.push_back((size_t)START_CELL_Y * w + START_CELL_X);
+    reached[stack.back()] = 1;
+    while (!stack.empty())
+    {
+        size_t cell = stack.back();
+        stack.pop_back();
+        int x = (int)(cell % w), y = (int)(cell / w);
+        for (int d = 0; d < 4; ++d)
+        {
+            int nx = x + DX[d], ny = y + DY[d];
+            if (nx < 0 || ny < 0 || nx >= w || ny >= h)
+                continue;
+            size_t next = (size_t)ny * w + nx;
+            if (!reached[next] && !isSolidTile(maze.get(nx, ny)))
+            {
+                reached[next] = 1;
+                stack.push_back(next);
+            }
+        }
+    }
+
+    bool vault = reached[(size_t)VAULT_CELL_Y * w + VAULT_CELL_X];
+    long long goldTiles = 0, goldUnits = 0, unreachable = 0;
+    for (int y = 0; y < h; ++y)
+    {
+        for (int x = 0; x < w; ++x)
+        {
+            const TileInfo &tile = tileInfo(maze.get(x, y));
+            if (!tile.gold)
+                continue;
+            goldTiles++;
+            goldUnits += tile.goldUnits;
+            if (!reached[(size_t)y * w + x])
+            {
+                if (unreachable < 10)
+                    std::cout << "  nieosiagalne zloto: (" << x << "," << y << ")\n";
+                unreachable++;
+            }
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    bool ok = vault && unreachable == 0;
+    std::cout << path << ": " << w << "x" << h << ", " << (ok ? "zloto osiagalne" : "NIE do przejscia")
+              << "\n  skarbiec: " << (vault ? "osiagalny" : "odciety") << ", zloto: " << goldUnits
+              << " szt. na " << goldTiles << " polach, nieosiagalne pola: " << unreachable
+              << "\n  pamiec planszy: " << maze.memoryBytes() / 1024 << " KB, cache kawalkow: "
+              << maze.cacheHits() << " trafien, " << maze.cacheMisses() << " chybien, " << seconds << " s\n";
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char *argv[])
+{
+    int count = 0;
+    int threads = (int)std::thread::hardware_concurrency();
+    uint64_t seed = 1;
+    int width = 22, height = 24;
+    SolverRules rules;
+
+    int i = 1;
+    for (; i < argc; ++i)
+    {
+        const char *a = argv[i];
+        if (!std::strcmp(a, "-n") && i + 1 < argc)
+            count = std::atoi(argv[++i]);
+        else if (!std::strcmp(a, "-j") && i + 1 < argc)
+            threads = std::atoi(argv[++i]);
+        else if (!std::strcmp(a, "-s") && i + 1 < argc)
+            seed = std::strtoull(argv[++i], NULL, 10);
+        else if (!std::strcmp(a, "-w") && i + 1 < argc)
+            width = std::atoi(argv[++i]);
+        else if (!std::strcmp(a, "-h") && i + 1 < argc)
+            height = std::atoi(argv[++i]);
+        else if (!std::strcmp(a, "--strict"))
+            rules.turnWhileMoving = false;
+        else if (!std::strcmp(a, "--large") && i + 1 < argc)
+            return checkLargeLevel(argv[i + 1]);
+        else
+            break;
+    }
+    if (i < argc)
+        return solveFiles(argc, argv, i, rules);
+    if (count <= 0)
+    {
+        std::cerr << "Uzycie: level_solver plik.txt [...]\n"
+                     "       level_solver -n LICZBA [-j WATKI] [-s ZIARNO] [-w SZER] [-h WYS]\n"
+                     "       level_solver --large plik.txt\n"
+                     "       --strict  ruch tylko po zatrzymaniu\n";
+        return 1;
+    }
+    if (threads < 1)
+        threads = 1;
+
+    // Każda plansza ma własne ziarno (seed + numer) i z niego własny strumień
+    // generatora, więc wynik nie zależy od liczby wątków
+    std::vector<LevelReport> reports(count);
+    std::atomic<int> next(0);
+    auto start = std::chrono::steady_clock::now();
+
+    auto worker = [&]()
+    {
+        while (true)
+        {
+            int n = next.fetch_add(1);
+            if (n >= count)
+                break;
+            Rng rng(rngStreamSeed(seed + n, RNG_MAZE_GEN, 0));
+            Maze maze = generateMaze(width, height, rng);
+            LevelSolver solver(maze, rules);
+            reports[n] = solver.solve();
+            reports[n].plan.clear(); // w trybie wsadowym wystarczą metryki
+        }
+    };
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t)
+        pool.push_back(std::thread(worker));
+    for (size_t t = 0; t < pool.size(); ++t)
+        pool[t].join();
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printCsvHeader();
+    int solvable = 0, exact = 0;
+    long long moves = 0;
+    for (int n = 0; n < count; ++n)
+    {
+        printCsvLine(std::to_string(seed + n), reports[n]);
+        if (reports[n].solvable)
+        {
+            solvable++;
+            moves += reports[n].moves;
+        }
+        exact += reports[n].exact;
+    }
+    std::cerr << "Plansze: " << count << ", do przejscia: " << solvable
+              << " (" << 100.0 * solvable / count << "%), plan optymalny: " << exact
+              << ", srednio ruchow: " << (solvable ? (double)moves / solvable : 0.0)
+              << "\nCzas: " << seconds << " s, " << count / seconds << " plansz/s, watki: "
+              << threads << std::endl;
+    return 0;
+}
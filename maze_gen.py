@@ -1,6 +1,8 @@
 import random
+import sys
 
-def generate_final_labyrinth_with_fixed_bottom(width, height):
+def generate_final_labyrinth_with_fixed_bottom(width, height, rng):
+    # rng is a random.Random - own state, same seed gives the same maze
     # Ensure dimensions are odd for proper maze structure
     if width % 2 == 0: width -= 1
     if height % 2 == 0: height -= 1
@@ -15,7 +17,7 @@ def generate_final_labyrinth_with_fixed_bottom(width, height):
     # Enhanced DFS for generating long corridors and diverse paths
     def dfs(x, y, depth=0):
         directions = [(0, 2), (2, 0), (0, -2), (-2, 0)]
-        random.shuffle(directions)
+        rng.shuffle(directions)
 
         for dx, dy in directions:
             nx, ny = x + dx, y + dy
@@ -28,7 +30,7 @@ def generate_final_labyrinth_with_fixed_bottom(width, height):
                 dfs(nx, ny, depth + 1)
 
     # Start DFS from a random cell
-    start_x, start_y = random.randrange(1, height, 2), random.randrange(1, width, 2)
+    start_x, start_y = rng.randrange(1, height, 2), rng.randrange(1, width, 2)
     maze[start_x][start_y] = 0
     dfs(start_x, start_y)
 
@@ -52,6 +54,11 @@ def generate_final_labyrinth_with_fixed_bottom(width, height):
                 if neighbors == 0:
                     maze[i][j] = 1
 
+    # Open the vault entrance above the player start (19,1) - without it gold
+    # can never be delivered (see level_solver)
+    if width > 20 and maze[1][19] == 0:
+        maze[0][19] = 0
+
     # Add treasures (3 and 4) in logical positions (dead ends)
     for i in range(1, height - 3, 2):  # Avoid the last three rows
         for j in range(1, width - 1, 2):
@@ -59,8 +66,8 @@ def generate_final_labyrinth_with_fixed_bottom(width, height):
                 # Check if this cell is a dead end
                 neighbors = sum(1 for dx, dy in [(-1, 0), (1, 0), (0, -1), (0, 1)]
                                 if maze[i + dx][j + dy] == 0)
-                if neighbors == 1 and random.random() > 0.6:  # Add treasure to some dead ends
-                    maze[i][j] = random.choice([3, 4])
+                if neighbors == 1 and rng.random() > 0.6:  # Add treasure to some dead ends
+                    maze[i][j] = rng.choice([3, 4])
 
     return maze
 
@@ -73,8 +80,10 @@ def save_maze_to_file(filename, maze):
             formatted_row = "{" + ",".join(map(str, row)) + "},"
             file.write(formatted_row + "\n")
 
-# Generate the maze
-final_labyrinth_fixed_bottom = generate_final_labyrinth_with_fixed_bottom(22, 24)
+# Generate the maze: python maze_gen.py [seed] (without a seed - random, printed for reuse)
+seed = int(sys.argv[1]) if len(sys.argv) > 1 else random.SystemRandom().randrange(2 ** 32)
+print("Seed: %d" % seed)
+final_labyrinth_fixed_bottom = generate_final_labyrinth_with_fixed_bottom(22, 24, random.Random(seed))
 
 # Save the maze to a file
 save_maze_to_file("mazeGen.txt", final_labyrinth_fixed_bottom)
@@ -0,0 +1,209 @@
+// Podgląd metryk działającej gry (raid_on_fort_knox --metrics) z zewnątrz.
+//
+//   metrics_top [-i MS] [-n NAZWA] [-1]
+//     -i  co ile milisekund wypisać linię (domyślnie 1000)
+//     -n  nazwa segmentu shm (domyślnie /raid_on_fort_knox)
+//     -1  jedna linia z sumami od startu gry i koniec
+//
+// Tylko czyta segment (mapowanie PROT_READ) - gra nie wie, że ktoś patrzy.
+// Tempo (FPS, kroki/s, punkty/min) i percentyle czasu klatki liczone są
+// z różnic między dwoma odczytami, więc pokazują ostatni przedział.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "include/Metrics.h"
+
+// Kopia liczników z jednej chwili
+struct MetricsSample
+{
+    uint32_t pid = 0;
+    uint32_t tickRate = 0;
+    uint64_t frames = 0, frameTimeSumUs = 0;
+    uint64_t frameTimeHist[METRICS_HIST_BUCKETS] = {};
+    uint64_t ticks = 0, deliveries = 0, goldPickups = 0, pantherHits = 0, restarts = 0;
+    int64_t score = 0;
+    uint64_t heartbeatNs = 0;
+    uint64_t cpuTimeUs = 0;
+    uint32_t idle = 0;
+    uint64_t inputs = 0;
+    uint64_t inputLatencyHist[METRICS_HIST_BUCKETS] = {};
+    uint64_t catchUpTicks = 0, droppedTicks = 0;
+    uint32_t renderTier = 0;
+    uint64_t startNs = 0;
+    uint64_t takenNs = 0;
+};
+
+const MetricsBlock *openMetrics(const std::string &name)
+{
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0)
+        return nullptr;
+    struct stat info;
+    void *mem = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && (size_t)info.st_size >= sizeof(MetricsBlock))
+        mem = mmap(nullptr, sizeof(MetricsBlock), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mem == MAP_FAILED)
+        return nullptr;
+    const MetricsBlock *block = static_cast<const MetricsBlock *>(mem);
+    if (block->magic.load(std::memory_order_acquire) != METRICS_MAGIC ||
+        block->layoutVersion != METRICS_LAYOUT_VERSION || block->blockSize != sizeof(MetricsBlock))
+    {
+        std::cerr << "Metrics layout mismatch in " << name << " (version " << block->layoutVersion
+                  << ", expected " << METRICS_LAYOUT_VERSION << ")" << std::endl;
+        munmap(mem, sizeof(MetricsBlock));
+        return nullptr;
+    }
+    return block;
+}
+
+bool takeSample(const MetricsBlock *b, MetricsSample &s)
+{
+    if (b->magic.load(std::memory_order_acquire) != METRICS_MAGIC)
+        return false; // gra się zamknęła
+    s.pid = b->pid;
+    s.tickRate = b->tickRate;
+    s.frames = b->frames.load(std::memory_order_relaxed);
+    s.frameTimeSumUs = b->frameTimeSumUs.load(std::memory_order_relaxed);
+    for (int i = 0; i < METRICS_HIST_BUCKETS; ++i)
+        s.frameTimeHist[i] = b->frameTimeHist[i].load(std::memory_order_relaxed);
+    s.ticks = b->ticks.load(std::memory_order_relaxed);
+    s.deliveries = b->deliveries.load(std::memory_order_relaxed);
+    s.goldPickups = b->goldPickups.load(std::memory_order_relaxed);
+    s.pantherHits = b->pantherHits.load(std::memory_order_relaxed);
+    s.restarts = b->restarts.load(std::memory_order_relaxed);
+    s.score = b->score.load(std::memory_order_relaxed);
+    s.heartbeatNs = b->heartbeatNs.load(std::memory_order_relaxed);
+    s.cpuTimeUs = b->cpuTimeUs.load(std::memory_order_relaxed);
+    s.idle = b->idle.load(std::memory_order_relaxed);
+    s.inputs = b->inputs.load(std::memory_order_relaxed);
+    for (int i = 0; i < METRICS_HIST_BUCKETS; ++i)
+        s.inputLatencyHist[i] = b->inputLatencyHist[i].load(std::memory_order_relaxed);
+    s.catchUpTicks = b->catchUpTicks.load(std::memory_order_relaxed);
+    s.droppedTicks = b->droppedTicks.load(std::memory_order_relaxed);
+    s.renderTier = b->renderTier.load(std::memory_order_relaxed);
+    s.startNs = b->startNs;
+    s.takenNs = MetricsRegistry::nowNs();
+    return true;
+}
+
+// Percentyl z histogramu różnic: górna granica przedziału, w ms
+double percentileMs(const uint64_t *hist, uint64_t total, double fraction)
+{
+    if (total == 0)
+        return 0.0;
+    uint64_t rank = (uint64_t)(fraction * (double)total);
+    uint64_t seen = 0;
+    for (int i = 0; i < METRICS_HIST_BUCKETS; ++i)
+    {
+        seen += hist[i];
+        if (seen > rank)
+            return metricsBucketLimit(i) / 1000.0;
+    }
+    return metricsBucketLimit(METRICS_HIST_BUCKETS - 1) / 1000.0;
+}
+
+void printLine(const MetricsSample &prev, const MetricsSample &cur)
+{
+    double seconds = (cur.takenNs - prev.takenNs) / 1e9;
+    if (seconds <= 0)
+        seconds = 1e-9;
+    uint64_t frames = cur.frames - prev.frames;
+    uint64_t hist[METRICS_HIST_BUCKETS];
+    for (int i = 0; i < METRICS_HIST_BUCKETS; ++i)
+        hist[i] = cur.frameTimeHist[i] - prev.frameTimeHist[i];
+    uint64_t inputs = cur.inputs - prev.inputs;
+    uint64_t inputHist[METRICS_HIST_BUCKETS];
+    for (int i = 0; i < METRICS_HIST_BUCKETS; ++i)
+        inputHist[i] = cur.inputLatencyHist[i] - prev.inputLatencyHist[i];
+    double meanMs = frames ? (cur.frameTimeSumUs - prev.frameTimeSumUs) / 1000.0 / frames : 0.0;
+    // Gra odświeża czas procesora co sekundę, więc przy krótkim -i bywa 0
+    double cpuPercent = (cur.cpuTimeUs - prev.cpuTimeUs) / 1e4 / seconds;
+    bool stale = cur.takenNs > cur.heartbeatNs && cur.takenNs - cur.heartbeatNs > 2000000000ull;
+
+    std::printf("fps %6.1f | klatka ms sr %6.2f p50 %6.2f p95 %6.2f p99 %6.2f | kroki/s %5.1f/%u"
+                " | punkty %lld (%.1f/min) | zloto %llu | pantera %llu | restarty %llu | cpu %5.1f%%"
+                " | wejscie ms p50 %5.1f p95 %5.1f (%llu) | nadrobione %llu porzucone %llu | jakosc %u%s%s\n",
+                frames / seconds, meanMs,
+                percentileMs(hist, frames, 0.50), percentileMs(hist, frames, 0.95),
+                percentileMs(hist, frames, 0.99),
+                (cur.ticks - prev.ticks) / seconds, cur.tickRate,
+                (long long)cur.score, (cur.deliveries - prev.deliveries) / seconds * 60.0,
+                (unsigned long long)cur.goldPickups, (unsigned long long)cur.pantherHits,
+                (unsigned long long)cur.restarts, cpuPercent,
+                percentileMs(inputHist, inputs, 0.50), percentileMs(inputHist, inputs, 0.95),
+                (unsigned long long)inputs,
+                (unsigned long long)(cur.catchUpTicks - prev.catchUpTicks),
+                (unsigned long long)(cur.droppedTicks - prev.droppedTicks), cur.renderTier,
+                cur.idle ? " [BEZCZYNNA]" : "", stale ? " [GRA STOI]" : "");
+    std::fflush(stdout);
+}
+
+int main(int argc, char *argv[])
+{
+    int intervalMs = 1000;
+    std::string name = METRICS_SHM_NAME;
+    bool once = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!std::strcmp(argv[i], "-i") && i + 1 < argc)
+            intervalMs = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "-n") && i + 1 < argc)
+            name = argv[++i];
+        else if (!std::strcmp(argv[i], "-1"))
+            once = true;
+        else
+        {
+            std::cerr << "Uzycie: metrics_top [-i MS] [-n NAZWA] [-1]\n";
+            return 1;
+        }
+    }
+    if (intervalMs < 50)
+        intervalMs = 50;
+
+    const MetricsBlock *block = openMetrics(name);
+    if (!block)
+    {
+        std::cerr << "No metrics segment " << name << " (start the game with --metrics)" << std::endl;
+        return 1;
+    }
+
+    MetricsSample prev, cur;
+    if (once)
+    {
+        // Od startu gry: poprzednia próbka to same zera z czasem startu
+        // (prawdziwy czas - suma czasów klatek pomija pauzy i bezczynność)
+        if (!takeSample(block, cur))
+            return 1;
+        prev.takenNs = cur.startNs;
+        printLine(prev, cur);
+        return 0;
+    }
+
+    takeSample(block, prev);
+    std::cout << "[METRICS] pid " << prev.pid << ", " << name << "\n";
+    while (true)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+        if (!takeSample(block, cur))
+        {
+            std::cout << "[METRICS] Gra zakonczona\n";
+            break;
+        }
+        printLine(prev, cur);
+        prev = cur;
+    }
+    munmap(const_cast<MetricsBlock *>(block), sizeof(MetricsBlock));
+    return 0;
+}
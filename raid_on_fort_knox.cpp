@@ -2,121 +2,87 @@
 #include <SDL2/SDL_ttf.h>
 #include <vector>
 #include <iostream>
-#include <cmath> // std::sqrt
 #include <string>
+#include <cerrno>
+#include <climits>
+#include <cstdio>
 #include <cstdlib>
-#include <ctime>
+#include <cstring>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
 
 #include "include/Sprites.h"
+#include "include/AllocCounter.h"
+#include "include/Arena.h"
+#include "include/Maze.h"
+#include "include/Levels.h"
+#include "include/LevelPack.h"
+#include "include/Tiles.h"
+#include "include/FixedPoint.h"
+#include "include/Simulation.h"
+#include "include/Snapshot.h"
+#include "include/World.h"
+#include "include/TripleBuffer.h"
+#include "include/SpscQueue.h"
+#include "include/RenderBatch.h"
+#include "include/BoardMesh.h"
+#include "include/FrameCapture.h"
+#include "include/Heatmap.h"
+#include "include/Metrics.h"
+#include "include/RenderTest.h"
+#include "include/FrameGovernor.h"
 
 // ----------------- USTAWIENIA ------------------------
+// (rozmiary kafelków, sprajtów i prędkości są w include/Simulation.h)
 
-// Rozmiar kafelka (tunel ma 1 kafelek szerokości)
-const int CELL_SIZE = 24;
-
-// Rozmiar "logiczne" sprajtów (używane do snapowania i kolizji bounding-box)
-// const int SPRITE_WIDTH do wykorzystania być może później
-const int CELL_SPRITE_WIDTH = 20;
-const int CELL_SPRITE_HEIGHT = 20;
-
-const int PLAYER_WIDTH = 20;
-const int PLAYER_HEIGHT = 20;
-const int START_WIDTH = 20;
-const int START_HEIGHT = 20;
-const int GOLD_WIDTH = 20;
-const int GOLD_HEIGHT = 20;
-const int GOLD2_WIDTH = 20;
-const int GOLD2_HEIGHT = 20;
-const int PANTHER_WIDTH = 20;
-const int PANTHER_HEIGHT = 20;
-
-// pozycja pantery
-float posPantherX = 11.0f * CELL_SIZE + (CELL_SIZE - PANTHER_WIDTH) / 2.0f;
-float posPantherY = 6.0f * CELL_SIZE + (CELL_SIZE - PANTHER_HEIGHT) / 2.0f;
+// Rozmiar okna graficznego
+const int WINDOW_WIDTH = 530;
+const int WINDOW_HEIGHT = 580;
 
-// Kierunek pantery w sensie pikseli (np. (1,0) to w prawo)
-float pantherSpeed = 1.0f; // Prędkość ruchu w pikselach/klatkę
-int pantherDirX = 0;       // Kierunek na osi X: 1 = w prawo, -1 = w lewo
-int pantherDirY = 1;       // Kierunek na osi Y: 1 = w dół, -1 = w górę
+// Tryb niskiej rozdzielczości: 1 piksel sprajta = 1 piksel tekstury, kafelek
+// ma SPRITE_WIDTH pikseli; gotowy obraz jest skalowany do okna całkowitą
+// wielokrotnością (z czarnymi pasami), jednym SDL_RenderCopy
+const int LOWRES_TILE = SPRITE_WIDTH;
 
-// pozycja drzwi startowych (skrarbca)
-float posStartX, posStartY;
+// Pamięć na dane tymczasowe jednej klatki (partie prostokątów, tekst HUD)
+const size_t FRAME_ARENA_SIZE = 512 * 1024;
 
-// czy pantera jest w trybie „bezpiecznym”?
-bool pantherIsDisabled = false;
+// Tyle pierwszych klatek może alokować (tekstury, bufory sterownika);
+// potem licznik w buildzie debug zgłasza każdą alokację w klatce
+const int ALLOC_WARMUP_FRAMES = 60;
 
-// licznik czasu, ile jeszcze pantera będzie wyłączona. coś nie bardzo działa i chyba nie jest używane
-int pantherDisableTimer = 5;
+// Backspace cofa grę o tyle zapisów historii (zapis co sekundę, World.h)
+const int ROLLBACK_SAVES = 3;
 
-// np. 180 klatek = ok. 3 sekundy (jeśli 60 FPS)
-const int PANTHER_DISABLE_TIME = 180;
+// Pauza albo ukryte okno: pętla śpi w SDL_WaitEventTimeout najwyżej tyle ms
+// (budzi ją każde zdarzenie; limit tylko po to, by co jakiś czas odświeżyć metryki)
+const int IDLE_WAIT_MS = 500;
 
-// Rozmiar okna graficznego
-const int WINDOW_WIDTH = 530;
-const int WINDOW_HEIGHT = 580;
+// Bez nowego kroku symulacji nie rysujemy, tylko czekamy chwilę na następny
+const int FRAME_POLL_DELAY_MS = 2;
 
-// Szybkość ruchu w pikselach na klatkę
-float speed = 2.0f;
+// Najwięcej kroków symulacji nadrabianych po jednym spóźnionym przebudzeniu
+// (8 = 133 ms); dłuższa przerwa to zatrzymanie gry, a nie przyspieszenie
+const int SIM_MAX_CATCHUP_TICKS = 8;
 
 // ----------------- KOLORY ELEMENTÓW GRY---------------------------
-const SDL_Color COLOR_WALL = {0, 0, 255, 255};                // Niebieski
-const SDL_Color COLOR_PLAYER = {0, 255, 0, 255};              // Zielony
-const SDL_Color COLOR_PATH = {0, 0, 0, 255};                  // Czarny (tło)
-const SDL_Color COLOR_LIVES = {255, 0, 0, 255};               // Czerwony
-const SDL_Color COLOR_START = {255, 255, 0, 255};             // Żółty
-const SDL_Color COLOR_GOLD = {255, 215, 0, 255};              // Złoty
-const SDL_Color COLOR_GOLD2 = {255, 115, 66, 255};            // Złoto "podwójne"
-const SDL_Color COLOR_PANTHER = {255, 0, 0, 255};             // Pantera
-const SDL_Color COLOR_PANTHER_DISABLED = {255, 255, 11, 255}; // Pantera pod kolizji
-
-// ----------------- POZYCJA GRACZA Pozycja w pikselach (lewy górny róg)--------------------
-float posPlayerX, posPlayerY;
-
-// Pozycja docelowa w pikselach
-float targetPlayerPosX, targetPlayerPosY;
-
-// Czy obecnie animujemy ruch
-bool isMoving = false;
-
-// ----------------- POZYCJA PANTERY --------------------
-bool justCollidedWithPanther = false;
-
-// Kierunek w sensie kafelków (np. (1,0) to w prawo)
-int dirCellX = 0, dirCellY = 0;
-
-// SPRAWDZENIE KOLIZJI Z BOUNDING-BOXEM PANTERY
-bool checkPantherBoxCollision(float x1, float y1, float w1, float h1,
-                              float x2, float y2, float w2, float h2)
+// (kolory kafelków są w tabeli include/Tiles.h)
+constexpr SDL_Color tileColor(const TileInfo &tile)
 {
-    // If one rectangle is on left side of other
-    if (x1 + w1 <= x2)
-        return false;
-    if (x2 + w2 <= x1)
-        return false;
-    if (y1 + h1 <= y2)
-        return false;
-    if (y2 + h2 <= y1)
-        return false;
-    return true;
+    return {tile.color.r, tile.color.g, tile.color.b, tile.color.a};
 }
 
-// SPRAWDZENIE KOLIZJI Z BOUNDING-BOXEM STARTU
-bool checkStartBoxCollision(float x1, float y1, float w1, float h1,
-                            float x2, float y2, float w2, float h2)
-{
-    // If one rectangle is on left side of other
-    if (x1 + w1 <= x2)
-        return false;
-    if (x2 + w2 <= x1)
-        return false;
-    if (y1 + h1 <= y2)
-        return false;
-    if (y2 + h2 <= y1)
-        return false;
-    return true;
-}
+const SDL_Color COLOR_WALL = tileColor(TILE_TABLE.info[TILE_WALL]);  // Niebieski
+const SDL_Color COLOR_PATH = tileColor(TILE_TABLE.info[TILE_PATH]);  // Czarny (tło)
+const SDL_Color COLOR_LIVES = tileColor(TILE_TABLE.info[TILE_LIFE]); // Czerwony
+const SDL_Color COLOR_PLAYER = {0, 255, 0, 255};                     // Zielony
+const SDL_Color COLOR_START = {255, 255, 0, 255};                    // Żółty
+const SDL_Color COLOR_PANTHER = {255, 0, 0, 255};                    // Pantera
+const SDL_Color COLOR_PANTHER_DISABLED = {255, 255, 11, 255};        // Pantera pod kolizji
 
-void drawPlayerSprite(SDL_Renderer *renderer, int x, int y)
+void drawPlayerSprite(RectBatcher &batch, int x, int y)
 {
     // Obliczamy skalę w pikselach
     int scaleX = PLAYER_WIDTH / SPRITE_WIDTH;   // 20 / 8 = 2
@@ -131,7 +97,6 @@ void drawPlayerSprite(SDL_Renderer *renderer, int x, int y)
 
             // Wybieramy kolor: zapalony = zielony, zgaszony = tło
             SDL_Color c = pixelOn ? COLOR_PLAYER : COLOR_PATH;
-            SDL_SetRenderDrawColor(renderer, c.r, c.g, c.b, c.a);
 
             // Rysujemy dokładnie dopasowany prostokąt
             SDL_Rect rect;
@@ -139,13 +104,13 @@ void drawPlayerSprite(SDL_Renderer *renderer, int x, int y)
             rect.y = y + row * scaleY;
             rect.w = scaleX;
             rect.h = scaleY;
-            SDL_RenderFillRect(renderer, &rect);
+            batch.add(c, rect);
         }
     }
 }
 
 // rysowanie gracza w prawo
-void drawPlayerSpriteRight(SDL_Renderer *renderer, int x, int y)
+void drawPlayerSpriteRight(RectBatcher &batch, int x, int y)
 {
     // Obliczamy skalę w pikselach
     int scaleX = PLAYER_WIDTH / SPRITE_WIDTH;   // 20 / 8 = 2
@@ -160,7 +125,6 @@ void drawPlayerSpriteRight(SDL_Renderer *renderer, int x, int y)
 
             // Wybieramy kolor: zapalony = zielony, zgaszony = tło
             SDL_Color c = pixelOn ? COLOR_PLAYER : COLOR_PATH;
-            SDL_SetRenderDrawColor(renderer, c.r, c.g, c.b, c.a);
 
             // Rysujemy dokładnie dopasowany prostokąt
             SDL_Rect rect;
@@ -168,13 +132,13 @@ void drawPlayerSpriteRight(SDL_Renderer *renderer, int x, int y)
             rect.y = y + row * scaleY;
             rect.w = scaleX;
             rect.h = scaleY;
-            SDL_RenderFillRect(renderer, &rect);
+            batch.add(c, rect);
         }
     }
 }
 
 // rysowanie gracza w dół
-void drawPlayerSpriteDown(SDL_Renderer *renderer, int x, int y)
+void drawPlayerSpriteDown(RectBatcher &batch, int x, int y)
 {
     // Obliczamy skalę w pikselach
     int scaleX = PLAYER_WIDTH / SPRITE_WIDTH;   // 20 / 8 = 2
@@ -189,7 +153,6 @@ void drawPlayerSpriteDown(SDL_Renderer *renderer, int x, int y)
 
             // Wybieramy kolor: zapalony = zielony, zgaszony = tło
             SDL_Color c = pixelOn ? COLOR_PLAYER : COLOR_PATH;
-            SDL_SetRenderDrawColor(renderer, c.r, c.g, c.b, c.a);
 
             // Rysujemy dokładnie dopasowany prostokąt
             SDL_Rect rect;
@@ -197,13 +160,13 @@ void drawPlayerSpriteDown(SDL_Renderer *renderer, int x, int y)
             rect.y = y + row * scaleY;
             rect.w = scaleX;
             rect.h = scaleY;
-            SDL_RenderFillRect(renderer, &rect);
+            batch.add(c, rect);
         }
     }
 }
 
 // rysowanie gracza w lewo
-void drawPlayerSpriteLeft(SDL_Renderer *renderer, int x, int y)
+void drawPlayerSpriteLeft(RectBatcher &batch, int x, int y)
 {
     // Obliczamy skalę w pikselach
     int scaleX = PLAYER_WIDTH / SPRITE_WIDTH;   // 20 / 8 = 2
@@ -218,7 +181,6 @@ void drawPlayerSpriteLeft(SDL_Renderer *renderer, int x, int y)
 
             // Wybieramy kolor: zapalony = zielony, zgaszony = tło
             SDL_Color c = pixelOn ? COLOR_PLAYER : COLOR_PATH;
-            SDL_SetRenderDrawColor(renderer, c.r, c.g, c.b, c.a);
 
             // Rysujemy dokładnie dopasowany prostokąt
             SDL_Rect rect;
@@ -226,55 +188,34 @@ void drawPlayerSpriteLeft(SDL_Renderer *renderer, int x, int y)
             rect.y = y + row * scaleY;
             rect.w = scaleX;
             rect.h = scaleY;
-            SDL_RenderFillRect(renderer, &rect);
+            batch.add(c, rect);
         }
     }
 }
 
-// Rysujemy pixel-art ZŁOTA w miejscu (x,y) o szerokości i wysokości
-// docelowej 20×20 (czyli skala 2.5, bo sprite ma 8×8).
-void drawGoldSprite(SDL_Renderer *renderer, float x, float y)
-{
-    // Obliczamy skalę tak, by sprite 8×8 zmieścił się w 20×20
-    float scaleX = (float)GOLD_WIDTH / (float)SPRITE_WIDTH;   // 20 / 8 = 2.5
-    float scaleY = (float)GOLD_HEIGHT / (float)SPRITE_HEIGHT; // 20 / 8 = 2.5
-
-    for (int row = 0; row < SPRITE_HEIGHT; row++)
-    {
-        for (int col = 0; col < SPRITE_WIDTH; col++)
-        {
-            bool pixelOn = goldSprite[row][col];
-            // Wybieramy kolor: zapalony = zielony, zgaszony = tło
-            SDL_Color c = pixelOn ? COLOR_GOLD : COLOR_PATH;
-            SDL_SetRenderDrawColor(renderer, c.r, c.g, c.b, c.a);
-            // Rysujemy kwadracik scaleX × scaleY
-            float drawX = x + col * scaleX;
-            float drawY = y + row * scaleY;
-            SDL_Rect rect;
-            rect.x = (int)drawX;
-            rect.y = (int)drawY;
-            rect.w = (int)scaleX;
-            rect.h = (int)scaleY;
-            SDL_RenderFillRect(renderer, &rect);
-        }
-    }
-}
+// Sprite'y kafelków według TileInfo::sprite
+static const bool (*const TILE_SPRITES[TILE_SPRITE_COUNT])[SPRITE_WIDTH] = {
+    nullptr,     // TILE_SPRITE_NONE
+    goldSprite,  // TILE_SPRITE_GOLD
+    gold2Sprite, // TILE_SPRITE_GOLD2
+};
 
-// Rysujemy pixel-art PODWÓJNEGO ZŁOTA w miejscu (x,y) o szerokości i wysokości
+// Rysujemy pixel-art kafelka (złoto itp.) w miejscu (x,y) o szerokości i wysokości
 // docelowej 20×20 (czyli skala 2.5, bo sprite ma 8×8).
-void drawGold2Sprite(SDL_Renderer *renderer, float x, float y)
+void drawTileSprite(BoardQuads &quads, const TileInfo &tile, float x, float y)
 {
     // Obliczamy skalę tak, by sprite 8×8 zmieścił się w 20×20
-    float scaleX = (float)GOLD2_WIDTH / (float)SPRITE_WIDTH;   // 20 / 8 = 2.5
-    float scaleY = (float)GOLD2_HEIGHT / (float)SPRITE_HEIGHT; // 20 / 8 = 2.5
+    float scaleX = (float)CELL_SPRITE_WIDTH / (float)SPRITE_WIDTH;   // 20 / 8 = 2.5
+    float scaleY = (float)CELL_SPRITE_HEIGHT / (float)SPRITE_HEIGHT; // 20 / 8 = 2.5
+    const bool(*sprite)[SPRITE_WIDTH] = TILE_SPRITES[tile.sprite];
+    SDL_Color on = tileColor(tile);
+
     for (int row = 0; row < SPRITE_HEIGHT; row++)
     {
         for (int col = 0; col < SPRITE_WIDTH; col++)
         {
-            bool pixelOn = gold2Sprite[row][col];
-            // Wybieramy kolor: zapalony = zielony, zgaszony = tło
-            SDL_Color c = pixelOn ? COLOR_GOLD2 : COLOR_PATH;
-            SDL_SetRenderDrawColor(renderer, c.r, c.g, c.b, c.a);
+            // Wybieramy kolor: zapalony = kolor kafelka, zgaszony = tło
+            SDL_Color c = sprite[row][col] ? on : COLOR_PATH;
             // Rysujemy kwadracik scaleX × scaleY
             float drawX = x + col * scaleX;
             float drawY = y + row * scaleY;
@@ -283,14 +224,14 @@ void drawGold2Sprite(SDL_Renderer *renderer, float x, float y)
             rect.y = (int)drawY;
             rect.w = (int)scaleX;
             rect.h = (int)scaleY;
-            SDL_RenderFillRect(renderer, &rect);
+            quads.add(c, rect);
         }
     }
 }
 
 // Rysujemy pixel-art PANTERY w miejscu (x,y) o szerokości i wysokości
 // docelowej 20×20 (czyli skala 2.5, bo sprite ma 8×8).
-void drawPantherSprite(SDL_Renderer *renderer, float x, float y, bool disabled)
+void drawPantherSprite(RectBatcher &batch, float x, float y, bool disabled)
 {
     // Obliczamy skalę tak, by sprite 8×8 zmieścił się w 20×20
     float scaleX = (float)PANTHER_WIDTH / (float)SPRITE_WIDTH;   // 20 / 8 = 2.5
@@ -302,7 +243,6 @@ void drawPantherSprite(SDL_Renderer *renderer, float x, float y, bool disabled)
             bool pixelOn = pantherSprite[row][col];
             // Wybieramy kolor: zapalony = zielony, zgaszony = tło
             SDL_Color c = pixelOn ? (disabled ? COLOR_PANTHER_DISABLED : COLOR_PANTHER) : COLOR_PATH;
-            SDL_SetRenderDrawColor(renderer, c.r, c.g, c.b, c.a);
             // Rysujemy kwadracik scaleX × scaleY
             float drawX = x + col * scaleX;
             float drawY = y + row * scaleY;
@@ -311,14 +251,14 @@ void drawPantherSprite(SDL_Renderer *renderer, float x, float y, bool disabled)
             rect.y = (int)drawY;
             rect.w = (int)scaleX;
             rect.h = (int)scaleY;
-            SDL_RenderFillRect(renderer, &rect);
+            batch.add(c, rect);
         }
     }
 }
 
 // Rysujemy pixel-art PANTERY w miejscu (x,y) o szerokości i wysokości
 // docelowej 20×20 (czyli skala 2.5, bo sprite ma 8×8).
-void drawPantherSpriteRight(SDL_Renderer *renderer, float x, float y, bool disabled)
+void drawPantherSpriteRight(RectBatcher &batch, float x, float y, bool disabled)
 {
     // Obliczamy skalę tak, by sprite 8×8 zmieścił się w 20×20
     float scaleX = (float)PANTHER_WIDTH / (float)SPRITE_WIDTH;   // 20 / 8 = 2.5
@@ -330,7 +270,6 @@ void drawPantherSpriteRight(SDL_Renderer *renderer, float x, float y, bool disab
             bool pixelOn = pantherSpriteRight[row][col];
             // Wybieramy kolor: zapalony = zielony, zgaszony = tło
             SDL_Color c = pixelOn ? (disabled ? COLOR_PANTHER_DISABLED : COLOR_PANTHER) : COLOR_PATH;
-            SDL_SetRenderDrawColor(renderer, c.r, c.g, c.b, c.a);
             // Rysujemy kwadracik scaleX × scaleY
             float drawX = x + col * scaleX;
             float drawY = y + row * scaleY;
@@ -339,14 +278,14 @@ void drawPantherSpriteRight(SDL_Renderer *renderer, float x, float y, bool disab
             rect.y = (int)drawY;
             rect.w = (int)scaleX;
             rect.h = (int)scaleY;
-            SDL_RenderFillRect(renderer, &rect);
+            batch.add(c, rect);
         }
     }
 }
 
 // Rysujemy pixel-art PANTERY w miejscu (x,y) o szerokości i wysokości
 // docelowej 20×20 (czyli skala 2.5, bo sprite ma 8×8).
-void drawPantherSpriteLeft(SDL_Renderer *renderer, float x, float y, bool disabled)
+void drawPantherSpriteLeft(RectBatcher &batch, float x, float y, bool disabled)
 {
     // Obliczamy skalę tak, by sprite 8×8 zmieścił się w 20×20
     float scaleX = (float)PANTHER_WIDTH / (float)SPRITE_WIDTH;   // 20 / 8 = 2.5
@@ -358,7 +297,6 @@ void drawPantherSpriteLeft(SDL_Renderer *renderer, float x, float y, bool disabl
             bool pixelOn = pantherSpriteLeft[row][col];
             // Wybieramy kolor: zapalony = zielony, zgaszony = tło
             SDL_Color c = pixelOn ? (disabled ? COLOR_PANTHER_DISABLED : COLOR_PANTHER) : COLOR_PATH;
-            SDL_SetRenderDrawColor(renderer, c.r, c.g, c.b, c.a);
             // Rysujemy kwadracik scaleX × scaleY
             float drawX = x + col * scaleX;
             float drawY = y + row * scaleY;
@@ -367,14 +305,14 @@ void drawPantherSpriteLeft(SDL_Renderer *renderer, float x, float y, bool disabl
             rect.y = (int)drawY;
             rect.w = (int)scaleX;
             rect.h = (int)scaleY;
-            SDL_RenderFillRect(renderer, &rect);
+            batch.add(c, rect);
         }
     }
 }
 
 // Rysujemy pixel-art PANTERY w miejscu (x,y) o szerokości i wysokości
 // docelowej 20×20 (czyli skala 2.5, bo sprite ma 8×8).
-void drawPantherSpriteDown(SDL_Renderer *renderer, float x, float y, bool disabled)
+void drawPantherSpriteDown(RectBatcher &batch, float x, float y, bool disabled)
 {
     // Obliczamy skalę tak, by sprite 8×8 zmieścił się w 20×20
     float scaleX = (float)PANTHER_WIDTH / (float)SPRITE_WIDTH;   // 20 / 8 = 2.5
@@ -386,7 +324,6 @@ void drawPantherSpriteDown(SDL_Renderer *renderer, float x, float y, bool disabl
             bool pixelOn = pantherSpriteDown[row][col];
             // Wybieramy kolor: zapalony = zielony, zgaszony = tło
             SDL_Color c = pixelOn ? (disabled ? COLOR_PANTHER_DISABLED : COLOR_PANTHER) : COLOR_PATH;
-            SDL_SetRenderDrawColor(renderer, c.r, c.g, c.b, c.a);
             // Rysujemy kwadracik scaleX × scaleY
             float drawX = x + col * scaleX;
             float drawY = y + row * scaleY;
@@ -395,14 +332,14 @@ void drawPantherSpriteDown(SDL_Renderer *renderer, float x, float y, bool disabl
             rect.y = (int)drawY;
             rect.w = (int)scaleX;
             rect.h = (int)scaleY;
-            SDL_RenderFillRect(renderer, &rect);
+            batch.add(c, rect);
         }
     }
 }
 
 // Rysujemy pixel-art IKONA STARTU GRACZA w miejscu (x,y) o szerokości i wysokości
 // docelowej 20×20 (czyli skala 2.5, bo sprite ma 8×8).
-void drawStartSprite(SDL_Renderer *renderer, float x, float y)
+void drawStartSprite(RectBatcher &batch, float x, float y)
 {
     // Obliczamy skalę tak, by sprite 8×8 zmieścił się w 20×20
     float scaleX = (float)START_WIDTH / (float)SPRITE_WIDTH;   // 20 / 8 = 2.5
@@ -414,7 +351,6 @@ void drawStartSprite(SDL_Renderer *renderer, float x, float y)
             bool pixelOn = startSprite[row][col];
             // Wybieramy kolor: zapalony = zielony, zgaszony = tło
             SDL_Color c = pixelOn ? COLOR_START : COLOR_PATH;
-            SDL_SetRenderDrawColor(renderer, c.r, c.g, c.b, c.a);
             // Rysujemy kwadracik scaleX × scaleY
             float drawX = x + col * scaleX;
             float drawY = y + row * scaleY;
@@ -423,203 +359,827 @@ void drawStartSprite(SDL_Renderer *renderer, float x, float y)
             rect.y = (int)drawY;
             rect.w = (int)scaleX;
             rect.h = (int)scaleY;
-            SDL_RenderFillRect(renderer, &rect);
+            batch.add(c, rect);
         }
     }
 }
 
-// (Opcjonalna) funkcja kolizji z rogami bounding-boxa
-bool checkCollisionWithWalls(float newX, float newY, const std::vector<std::vector<int>> &maze)
+// Funkcja do rysowania prostokąta - używana przy ścianach, złocie, itp.
+void drawRect(RectBatcher &batch, int x, int y, int w, int h, SDL_Color color)
 {
-    float left = newX;
-    float top = newY;
-    float right = newX + PLAYER_WIDTH - 1;
-    float bottom = newY + PLAYER_HEIGHT - 1;
+    SDL_Rect rect = {x, y, w, h};
+    batch.add(color, rect);
+}
 
-    auto isWallAtPixel = [&](float px, float py)
+// Tekstura z tekstem (nullptr przy błędzie); w, h - rozmiar w pikselach
+SDL_Texture *createTextTexture(SDL_Renderer *renderer, TTF_Font *font, const char *text, SDL_Color color, int &w, int &h)
+{
+    SDL_Surface *surface = TTF_RenderText_Solid(font, text, color);
+    if (!surface)
     {
-        if (px < 0 || py < 0)
-            return true; // poza mapą
-        int tileX = (int)(px / CELL_SIZE);
-        int tileY = (int)(py / CELL_SIZE);
-        if (tileY < 0 || tileY >= (int)maze.size() ||
-            tileX < 0 || tileX >= (int)maze[tileY].size())
-        {
-            return true; // poza tablicą
-        }
-        return (maze[tileY][tileX] == 1);
-    };
+        std::cerr << "Failed to create text surface: " << TTF_GetError() << std::endl;
+        return nullptr;
+    }
+    SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
+    if (!texture)
+    {
+        std::cerr << "Failed to create text texture: " << TTF_GetError() << std::endl;
+        SDL_FreeSurface(surface);
+        return nullptr;
+    }
+    w = surface->w;
+    h = surface->h;
+    SDL_FreeSurface(surface);
+    return texture;
+}
 
-    if (isWallAtPixel(left, top))
-        return true;
-    if (isWallAtPixel(right, top))
-        return true;
-    if (isWallAtPixel(left, bottom))
-        return true;
-    if (isWallAtPixel(right, bottom))
-        return true;
+// Funkcja do rysowania tekstu (jednorazowego - tworzy i niszczy teksturę)
+void renderText(SDL_Renderer *renderer, TTF_Font *font, const char *text, int x, int y, SDL_Color color)
+{
+    int w, h;
+    SDL_Texture *texture = createTextTexture(renderer, font, text, color, w, h);
+    if (!texture)
+        return;
+    SDL_Rect destRect = {x, y, w, h};
+    SDL_RenderCopy(renderer, texture, NULL, &destRect);
+    SDL_DestroyTexture(texture);
+}
+
+// Tekstura z liczbą punktów - tworzona od nowa tylko przy zmianie wyniku
+struct ScoreTexture
+{
+    SDL_Texture *texture = nullptr;
+    int w = 0, h = 0;
+    int32_t score = 0;
+};
+
+// true, jeśli tekstura była tworzona od nowa (taka klatka alokuje)
+bool updateScoreTexture(SDL_Renderer *renderer, TTF_Font *font, Arena &frameArena,
+                        ScoreTexture &hud, int32_t score)
+{
+    if (hud.texture && hud.score == score)
+        return false;
+
+    const size_t textSize = 32;
+    char *text = (char *)frameArena.allocate(textSize, 1);
+    if (!text)
+        return false;
+    std::snprintf(text, textSize, "Punkty: %d", (int)score);
+
+    int w, h;
+    SDL_Texture *texture = createTextTexture(renderer, font, text, {255, 255, 255, 255}, w, h);
+    if (!texture)
+        return false;
+    if (hud.texture)
+        SDL_DestroyTexture(hud.texture);
+    hud.texture = texture;
+    hud.w = w;
+    hud.h = h;
+    hud.score = score;
+    return true;
+}
 
-    return false;
+// Polecenie gracza przekazywane do wątku symulacji
+struct PlayerCommand
+{
+    int dirX = 0, dirY = 0;
+    bool restart = false; // R - poziom od nowa
+    bool rewind = false;  // Backspace - cofnięcie o ROLLBACK_SAVES sekund
+    uint32_t timestamp = 0; // event.key.timestamp (ms od SDL_Init)
+};
+
+// Strzałka -> kierunek w kafelkach; false dla innych klawiszy
+bool directionForKey(SDL_Keycode key, int &dirX, int &dirY)
+{
+    dirX = dirY = 0;
+    if (key == SDLK_UP)
+        dirY = -1;
+    else if (key == SDLK_DOWN)
+        dirY = 1;
+    else if (key == SDLK_LEFT)
+        dirX = -1;
+    else if (key == SDLK_RIGHT)
+        dirX = 1;
+    else
+        return false;
+    return true;
 }
 
-// (Opcjonalna) funkcja kolizji z rogami bounding-boxa pantery
-bool checkPantherCollisionWithWalls(float newX, float newY, const std::vector<std::vector<int>> &maze)
+// Nakładka z mapą ciepła z headless_sim (--heatmap plik.heat, F4 zmienia warstwę)
+struct HeatOverlay
 {
-    float left = newX;
-    float top = newY;
-    float right = newX + PANTHER_WIDTH - 1;
-    float bottom = newY + PANTHER_HEIGHT - 1;
+    TileHeatmap map;
+    int layer = -1; // -1 = wyłączona
+    uint32_t maxCount = 0;
+};
 
-    auto isWallAtPixel = [&](float px, float py)
+// Ile odcieni nakładki (każdy to jedna partia prostokątów)
+const int HEAT_OVERLAY_LEVELS = 8;
+
+// F4: wyłączona -> kolejne warstwy -> wyłączona
+void cycleHeatOverlay(HeatOverlay &overlay)
+{
+    if (overlay.map.counts.empty())
+        return;
+    overlay.layer = overlay.layer + 1 < HEAT_LAYER_COUNT ? overlay.layer + 1 : -1;
+    if (overlay.layer >= 0)
     {
-        if (px < 0 || py < 0)
-            return true; // poza mapą
-        int tileX = (int)(px / CELL_SIZE);
-        int tileY = (int)(py / CELL_SIZE);
-        if (tileY < 0 || tileY >= (int)maze.size() ||
-            tileX < 0 || tileX >= (int)maze[tileY].size())
+        overlay.maxCount = overlay.map.maxOf(overlay.layer);
+        std::cout << "[HEATMAP] Warstwa: " << HEAT_LAYER_NAMES[overlay.layer]
+                  << " (max " << overlay.maxCount << ")\n";
+    }
+}
+
+// Półprzezroczyste kafelki, tym mocniejsze, im większy licznik w warstwie
+void drawHeatOverlay(SDL_Renderer *renderer, RectBatcher &batch, const HeatOverlay &overlay, int tileSize)
+{
+    if (overlay.layer < 0 || overlay.maxCount == 0)
+        return;
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    for (int y = 0; y < overlay.map.height; ++y)
+    {
+        for (int x = 0; x < overlay.map.width; ++x)
         {
-            return true; // poza tablicą
+            uint32_t count = overlay.map.get(overlay.layer, x, y);
+            if (count == 0)
+                continue;
+            int level = 1 + (int)((uint64_t)count * (HEAT_OVERLAY_LEVELS - 1) / overlay.maxCount);
+            SDL_Color c = {255, 64, 0, (Uint8)(level * 200 / HEAT_OVERLAY_LEVELS)};
+            drawRect(batch, x * tileSize, y * tileSize, tileSize, tileSize, c);
         }
-        return (maze[tileY][tileX] == 1);
-    };
+    }
+    batch.flush();
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+}
 
-    if (isWallAtPixel(left, top))
-        return true;
-    if (isWallAtPixel(right, top))
-        return true;
-    if (isWallAtPixel(left, bottom))
-        return true;
-    if (isWallAtPixel(right, bottom))
+// Jeden kafelek labiryntu do siatki planszy (include/BoardMesh.h);
+// wołane z wątków puli, więc tylko tablice stałe i quads
+void emitBoardTile(BoardQuads &quads, uint8_t value, int x, int y)
+{
+    const TileInfo &tile = tileInfo(value);
+    if (tile.layer == TILE_LAYER_SPRITE)
+    {
+        drawTileSprite(quads, tile, x, y);
+    }
+    else
+    {
+        SDL_Rect rect = {x, y, CELL_SIZE, CELL_SIZE};
+        quads.add(tileColor(tile), rect);
+    }
+}
+
+// Rysowanie labiryntu (na tle COLOR_PATH): siatka budowana od nowa tylko
+// w kawałkach ze zmienionymi kafelkami, cała plansza jednym wywołaniem
+void drawBoardTiles(SDL_Renderer *renderer, BoardMesh &mesh, const WorldSnapshot &snap)
+{
+    mesh.update(&snap.tiles[0][0], SNAPSHOT_MAX_WIDTH, snap.width, snap.height, CELL_SIZE, snap.tilesVersion,
+                emitBoardTile);
+    mesh.draw(renderer);
+}
+
+// Plansza w teksturze (RENDER_TIER_CACHED): rysowana od nowa tylko wtedy,
+// gdy zmieniły się kafelki migawki; tekstura powstaje przy pierwszym użyciu
+struct BoardCache
+{
+    SDL_Texture *texture = nullptr;
+    int w = 0, h = 0;
+    uint32_t tilesVersion = ~0u;
+};
+
+// false, gdy tekstury nie da się utworzyć (wtedy rysujemy bez cache)
+bool updateBoardCache(SDL_Renderer *renderer, BoardMesh &mesh, BoardCache &board, const WorldSnapshot &snap)
+{
+    int w = snap.width * CELL_SIZE, h = snap.height * CELL_SIZE;
+    if (!board.texture || board.w != w || board.h != h)
+    {
+        if (board.texture)
+            SDL_DestroyTexture(board.texture);
+        board.texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, w, h);
+        if (!board.texture)
+            return false;
+        // Kopia 1:1 bez mieszania - te same piksele co rysowanie wprost
+        SDL_SetTextureBlendMode(board.texture, SDL_BLENDMODE_NONE);
+        board.w = w;
+        board.h = h;
+        board.tilesVersion = ~snap.tilesVersion;
+    }
+    if (board.tilesVersion == snap.tilesVersion)
         return true;
 
-    return false;
+    SDL_Texture *previous = SDL_GetRenderTarget(renderer);
+    SDL_SetRenderTarget(renderer, board.texture);
+    SDL_SetRenderDrawColor(renderer, COLOR_PATH.r, COLOR_PATH.g, COLOR_PATH.b, COLOR_PATH.a);
+    SDL_RenderClear(renderer);
+    drawBoardTiles(renderer, mesh, snap);
+    SDL_SetRenderTarget(renderer, previous);
+    board.tilesVersion = snap.tilesVersion;
+    return true;
 }
 
-// Funkcja do obliczenia, dokąd można dojść w danym kierunku (dx, dy) aż do ściany.
-void computeTargetCell(
-    const std::vector<std::vector<int>> &maze,
-    int startCellX, int startCellY,
-    int dx, int dy,
-    int &outX, int &outY)
+// Rysowanie jednej klatki na podstawie migawki świata
+// (bez alokacji: prostokąty idą do pamięci klatki, napis z punktami jest w gotowej teksturze)
+// Z board != NULL plansza jest kopiowana z cache, a nakładka ciepła pominięta
+void renderSnapshot(SDL_Renderer *renderer, Arena &frameArena, const ScoreTexture &hud,
+                    const HeatOverlay &overlay, const WorldSnapshot &snap, BoardMesh &mesh, BoardCache *board)
 {
-    int newX = startCellX;
-    int newY = startCellY;
+    if (board && !updateBoardCache(renderer, mesh, *board, snap))
+        board = NULL;
+
+    SDL_SetRenderDrawColor(renderer, COLOR_PATH.r, COLOR_PATH.g, COLOR_PATH.b, COLOR_PATH.a);
+    SDL_RenderClear(renderer);
+
+    RectBatcher batch(renderer, frameArena);
+
+    if (board)
+    {
+        SDL_Rect dest = {0, 0, board->w, board->h};
+        SDL_RenderCopy(renderer, board->texture, NULL, &dest);
+    }
+    else
+    {
+        drawBoardTiles(renderer, mesh, snap);
+        drawHeatOverlay(renderer, batch, overlay, CELL_SIZE);
+    }
+
+    // Rysowanie punktów
+    if (hud.texture)
+    {
+        SDL_Rect destRect = {5 * CELL_SIZE, 0, hud.w, hud.h};
+        SDL_RenderCopy(renderer, hud.texture, NULL, &destRect);
+    }
+
+    // *** RYSOWANIE GRACZA: pixel-art sprite ***
+    switch (snap.playerFacing)
+    {
+    case FACING_RIGHT:
+        drawPlayerSpriteRight(batch, snap.playerX, snap.playerY);
+        break;
+    case FACING_LEFT:
+        drawPlayerSpriteLeft(batch, snap.playerX, snap.playerY);
+        break;
+    case FACING_DOWN:
+        drawPlayerSpriteDown(batch, snap.playerX, snap.playerY);
+        break;
+    default:
+        drawPlayerSprite(batch, snap.playerX, snap.playerY);
+        break;
+    }
+    batch.flush();
 
-    while (true)
+    // Rysowanie panter (każda osobno - mogą na siebie nachodzić)
+    for (int p = 0; p < snap.pantherCount; ++p)
     {
-        int testX = newX + dx;
-        int testY = newY + dy;
+        const PantherSnapshot &panther = snap.panthers[p];
+        drawPantherSprite(batch, panther.x, panther.y, panther.disabled);
+        batch.flush();
+    }
 
-        if (testY < 0 || testY >= (int)maze.size() ||
-            testX < 0 || testX >= (int)maze[testY].size())
+    drawStartSprite(batch, VAULT_CELL_X * CELL_SIZE, VAULT_CELL_Y * CELL_SIZE);
+}
+
+// ----------------- TRYB NISKIEJ ROZDZIELCZOŚCI ---------
+
+// Sprite 8×8 w skali 1:1 (bez zaokrągleń skali 2.5, więc bez szpar)
+void drawSpriteNative(RectBatcher &batch, const bool sprite[SPRITE_HEIGHT][SPRITE_WIDTH],
+                      int x, int y, SDL_Color color)
+{
+    for (int row = 0; row < SPRITE_HEIGHT; row++)
+    {
+        for (int col = 0; col < SPRITE_WIDTH; col++)
         {
-            break; // poza tablicą
+            SDL_Color c = sprite[row][col] ? color : COLOR_PATH;
+            SDL_Rect rect = {x + col, y + row, 1, 1};
+            batch.add(c, rect);
         }
-        if (maze[testY][testX] == 1)
+    }
+}
+
+// Pozycja obiektu (lewy górny róg w pikselach okna, wyśrodkowany w kafelku)
+// -> lewy górny róg w teksturze niskiej rozdzielczości
+int toLowRes(int pos, int size)
+{
+    return (pos - (CELL_SIZE - size) / 2) * LOWRES_TILE / CELL_SIZE;
+}
+
+// Ta sama klatka co renderSnapshot, ale do tekstury LOWRES_TILE pikseli na kafelek
+// (napis z punktami rysuje presentLowRes już w rozdzielczości okna)
+void renderSnapshotLowRes(SDL_Renderer *renderer, Arena &frameArena, const HeatOverlay &overlay,
+                          const WorldSnapshot &snap)
+{
+    SDL_SetRenderDrawColor(renderer, COLOR_PATH.r, COLOR_PATH.g, COLOR_PATH.b, COLOR_PATH.a);
+    SDL_RenderClear(renderer);
+
+    RectBatcher batch(renderer, frameArena);
+
+    for (int y = 0; y < snap.height; ++y)
+    {
+        for (int x = 0; x < snap.width; ++x)
         {
-            break; // ściana
+            const TileInfo &tile = tileInfo(snap.tiles[y][x]);
+            int px = x * LOWRES_TILE;
+            int py = y * LOWRES_TILE;
+            if (tile.layer == TILE_LAYER_SPRITE)
+                drawSpriteNative(batch, TILE_SPRITES[tile.sprite], px, py, tileColor(tile));
+            else
+                drawRect(batch, px, py, LOWRES_TILE, LOWRES_TILE, tileColor(tile));
         }
-        newX = testX;
-        newY = testY;
     }
-    outX = newX;
-    outY = newY;
+    batch.flush();
+    drawHeatOverlay(renderer, batch, overlay, LOWRES_TILE);
+
+    int playerX = toLowRes(snap.playerX, PLAYER_WIDTH);
+    int playerY = toLowRes(snap.playerY, PLAYER_HEIGHT);
+    switch (snap.playerFacing)
+    {
+    case FACING_RIGHT:
+        drawSpriteNative(batch, playerSpriteRight, playerX, playerY, COLOR_PLAYER);
+        break;
+    case FACING_LEFT:
+        drawSpriteNative(batch, playerSpriteLeft, playerX, playerY, COLOR_PLAYER);
+        break;
+    case FACING_DOWN:
+        drawSpriteNative(batch, playerSpriteDown, playerX, playerY, COLOR_PLAYER);
+        break;
+    default:
+        drawSpriteNative(batch, playerSprite, playerX, playerY, COLOR_PLAYER);
+        break;
+    }
+    batch.flush();
+
+    for (int p = 0; p < snap.pantherCount; ++p)
+    {
+        const PantherSnapshot &panther = snap.panthers[p];
+        drawSpriteNative(batch, pantherSprite,
+                         toLowRes(panther.x, PANTHER_WIDTH), toLowRes(panther.y, PANTHER_HEIGHT),
+                         panther.disabled ? COLOR_PANTHER_DISABLED : COLOR_PANTHER);
+        batch.flush();
+    }
+
+    drawSpriteNative(batch, startSprite, VAULT_CELL_X * LOWRES_TILE, VAULT_CELL_Y * LOWRES_TILE, COLOR_START);
 }
 
-// Funkcja do rysowania prostokąta - używana przy ścianach, złocie, itp.
-void drawRect(SDL_Renderer *renderer, int x, int y, int w, int h, SDL_Color color)
+// Skalowanie tekstury do okna: największa całkowita skala, obraz na środku
+void presentLowRes(SDL_Renderer *renderer, SDL_Texture *target, const ScoreTexture &hud)
 {
-    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-    SDL_Rect rect = {x, y, w, h};
-    SDL_RenderFillRect(renderer, &rect);
+    int outW, outH, texW, texH;
+    SDL_GetRendererOutputSize(renderer, &outW, &outH);
+    SDL_QueryTexture(target, NULL, NULL, &texW, &texH);
+
+    int scale = outW / texW < outH / texH ? outW / texW : outH / texH;
+    if (scale < 1)
+        scale = 1;
+    SDL_Rect dest = {(outW - texW * scale) / 2, (outH - texH * scale) / 2, texW * scale, texH * scale};
+
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    SDL_RenderClear(renderer);
+    SDL_RenderCopy(renderer, target, NULL, &dest);
+
+    if (hud.texture)
+    {
+        SDL_Rect destRect = {dest.x + 5 * LOWRES_TILE * scale, dest.y, hud.w, hud.h};
+        SDL_RenderCopy(renderer, hud.texture, NULL, &destRect);
+    }
+}
+
+// Cała klatka; lowResTarget == NULL - pełna rozdzielczość,
+// board != NULL - plansza z cache (tylko pełna rozdzielczość)
+void drawFrame(SDL_Renderer *renderer, Arena &frameArena, const ScoreTexture &hud,
+               const HeatOverlay &overlay, const WorldSnapshot &snap, SDL_Texture *lowResTarget,
+               BoardMesh &mesh, BoardCache *board)
+{
+    if (lowResTarget)
+    {
+        SDL_SetRenderTarget(renderer, lowResTarget);
+        renderSnapshotLowRes(renderer, frameArena, overlay, snap);
+        SDL_SetRenderTarget(renderer, NULL);
+        presentLowRes(renderer, lowResTarget, hud);
+    }
+    else
+    {
+        renderSnapshot(renderer, frameArena, hud, overlay, snap, mesh, board);
+    }
 }
 
-// Funkcja do rysowania tekstu
-void renderText(SDL_Renderer *renderer, TTF_Font *font, const std::string &text, int x, int y, SDL_Color color)
+// Nagrywanie zawsze w rozmiarze wyjścia renderera (po zmianie rozmiaru okna
+// klatki są pomijane aż do ponownego startu)
+bool startCapture(FrameCapture &capture, SDL_Renderer *renderer, const std::string &path)
 {
-    SDL_Surface *surface = TTF_RenderText_Solid(font, text.c_str(), color);
+    int w, h;
+    SDL_GetRendererOutputSize(renderer, &w, &h);
+    return capture.start(path, w, h, SIM_TICK_RATE);
+}
+
+// Wątek symulacji: stałe tempo SIM_TICK_RATE kroków na sekundę, niezależne
+// od tego, jak długo trwa renderowanie i SDL_RenderPresent (spóźnione kroki
+// są nadrabiane, do SIM_MAX_CATCHUP_TICKS naraz)
+// Restart poziomu też wykonuje się tutaj (arena poziomu należy do tego wątku)
+// W pauzie (P albo ukryte okno) wątek śpi na paused.wait - zero pobudek
+void runSimulation(GameState &game, Arena &levelArena, const TileGrid &level,
+                   SpscQueue<PlayerCommand, 64> &input,
+                   TripleBuffer<WorldSnapshot> &snapshots, MetricsRegistry &metrics,
+                   std::atomic<bool> &running, std::atomic<bool> &paused)
+{
+    typedef std::chrono::steady_clock Clock;
+    const Clock::duration tick = std::chrono::nanoseconds(1000000000 / SIM_TICK_RATE);
+    Clock::time_point nextTick = Clock::now();
+    uint32_t tickCount = 0;
+    MetricsBlock &stats = metrics.block();
+    WorldHistory history;
+
+    // Pomiar opóźnienia wejścia: strzałka czeka, aż gracz ruszy w jej kierunku
+    // (od razu albo po buforowanym skręcie); wtedy jej znacznik idzie do migawek
+    uint32_t inputStamp = 0, visibleInputStamp = 0;
+    int inputDirX = 0, inputDirY = 0;
+
+    while (running)
+    {
+        if (paused.load())
+        {
+            paused.wait(true);
+            nextTick = Clock::now(); // po pauzie nie nadrabiamy kroków
+            continue;
+        }
+
+        // Ile kroków jest należnych: zwykle jeden, pod obciążeniem (wątek
+        // obudził się za późno) więcej - nadrabiamy je od razu, więc tempo gry
+        // się nie zmienia. Ponad SIM_MAX_CATCHUP_TICKS (np. uśpienie systemu)
+        // reszta przepada.
+        Clock::time_point now = Clock::now();
+        int due = now > nextTick ? 1 + (int)((now - nextTick) / tick) : 1;
+        if (due > SIM_MAX_CATCHUP_TICKS)
+        {
+            metrics.add(stats.droppedTicks, due - SIM_MAX_CATCHUP_TICKS);
+            due = SIM_MAX_CATCHUP_TICKS;
+            nextTick = now - (due - 1) * tick;
+        }
+        metrics.add(stats.catchUpTicks, due - 1);
+
+        for (int step = 0; step < due; ++step)
+        {
+            PlayerCommand cmd;
+            while (input.pop(cmd))
+            {
+                if (cmd.restart)
+                {
+                    restartLevel(game, levelArena, level);
+                    history.clear(game);
+                    metrics.add(stats.restarts, 1);
+                    inputStamp = 0;
+                }
+                else if (cmd.rewind)
+                {
+                    if (history.rollback(game, ROLLBACK_SAVES))
+                        std::cout << "[DEBUG] Cofnięcie o " << ROLLBACK_SAVES << " s\n";
+                    inputStamp = 0;
+                }
+                else
+                {
+                    handleDirectionInput(game, cmd.dirX, cmd.dirY);
+                    inputStamp = cmd.timestamp;
+                    inputDirX = cmd.dirX;
+                    inputDirY = cmd.dirY;
+                }
+            }
+
+            // Liczniki poziomu zerują się przy restarcie, więc metryki dostają różnice
+            int score = game.score, pickups = game.goldPickups, hits = game.pantherHits;
+            fixed_t fromX = game.posPlayerX, fromY = game.posPlayerY;
+            stepSimulation(game);
+            if (inputStamp)
+            {
+                if ((game.posPlayerX - fromX) * inputDirX > 0 || (game.posPlayerY - fromY) * inputDirY > 0)
+                {
+                    visibleInputStamp = inputStamp;
+                    inputStamp = 0;
+                }
+                else if (game.pendingTurnTicks == 0 &&
+                         (!game.isMoving || game.dirCellX != inputDirX || game.dirCellY != inputDirY))
+                {
+                    inputStamp = 0; // ruch w tę stronę nie nastąpi (ściana, bufor wygasł)
+                }
+            }
+            history.record(game);
+            tickCount++;
+            metrics.add(stats.deliveries, game.score - score);
+            metrics.add(stats.goldPickups, game.goldPickups - pickups);
+            metrics.add(stats.pantherHits, game.pantherHits - hits);
+            metrics.tick(game.score);
+        }
+
+        // Migawka raz na partię kroków - render i tak pokaże tylko ostatni
+        writeSnapshot(game, tickCount, snapshots.writeBuffer());
+        snapshots.writeBuffer().inputStamp = visibleInputStamp;
+        snapshots.publish();
+
+        nextTick += due * tick;
+        std::this_thread::sleep_until(nextTick);
+    }
+}
+
+// Test renderowania bez okna (--render-test SKRYPT, include/RenderTest.h):
+// symulacja i rysowanie w jednym wątku, jedna klatka na krok, do powierzchni
+// w pamięci. Wypisuje CSV z czasem i skrótem każdej klatki; z --golden
+// porównuje skróty z plikiem (z --update-golden - zapisuje go).
+// Kod wyjścia 1, gdy którakolwiek klatka się różni albo pliku nie ma.
+int runRenderTest(TTF_Font *font, const TileGrid &level, HeatOverlay &overlay, bool lowRes, int tier,
+                  const char *scriptPath, const char *goldenPath, bool updateGolden)
+{
+    RenderScript script;
+    if (!loadRenderScript(scriptPath, script, SIM_TICK_RATE))
+        return 1;
+
+    // Brak pliku ze skrótami to błąd, nie nagrywanie - pomyłka w ścieżce
+    // nie może dać zielonego testu; nowy plik tylko z --update-golden
+    std::vector<uint64_t> golden;
+    bool compare = goldenPath && !updateGolden;
+    if (compare && !loadGoldenHashes(goldenPath, golden))
+    {
+        std::cerr << "Cannot open golden hashes: " << goldenPath << " (use --update-golden to create it)"
+                  << std::endl;
+        return 1;
+    }
+    if (updateGolden && !goldenPath)
+    {
+        std::cerr << "--update-golden needs --golden FILE" << std::endl;
+        return 1;
+    }
+    if (updateGolden)
+        std::cout << "[RENDER] Nowe złote skróty: " << goldenPath << "\n";
+
+    SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormat(0, WINDOW_WIDTH, WINDOW_HEIGHT, 32, SDL_PIXELFORMAT_ARGB8888);
     if (!surface)
     {
-        std::cerr << "Failed to create text surface: " << TTF_GetError() << std::endl;
-        return;
+        std::cerr << "Offscreen surface creation failed: " << SDL_GetError() << std::endl;
+        return 1;
     }
-    SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer, surface);
-    if (!texture)
+    SDL_Renderer *renderer = SDL_CreateSoftwareRenderer(surface);
+    if (!renderer)
     {
-        std::cerr << "Failed to create text texture: " << TTF_GetError() << std::endl;
+        std::cerr << "Software renderer creation failed: " << SDL_GetError() << std::endl;
         SDL_FreeSurface(surface);
-        return;
+        return 1;
     }
-    SDL_Rect destRect = {x, y, surface->w, surface->h};
-    SDL_RenderCopy(renderer, texture, NULL, &destRect);
+    SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "0"); // jak w oknie
+    SDL_Texture *lowResTarget = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                                  level.width * LOWRES_TILE, level.height * LOWRES_TILE);
+    if (!lowResTarget)
+        lowRes = false;
+
+    Arena levelArena(levelArenaBytes(level.width, level.height, 1));
+    GameState game;
+    game.turnBufferTicks = TURN_BUFFER_TICKS;
+    if (!initGameState(game, levelArena, level))
+    {
+        std::cerr << "Level arena too small" << std::endl;
+        SDL_DestroyRenderer(renderer);
+        SDL_FreeSurface(surface);
+        return 1;
+    }
+    WorldHistory history;
+    WorldSnapshot snap;
+    Arena frameArena(FRAME_ARENA_SIZE);
+    ScoreTexture hud;
+    uint32_t hudTick = 0;
+    // Stały poziom regulatora (--tier), żeby porównać tańsze rysowanie z pełnym
+    BoardCache board;
+    BoardMesh mesh(boardMeshWorkers());
+
+    std::vector<uint64_t> hashes;
+    std::vector<uint64_t> times;
+    hashes.reserve(script.ticks);
+    times.reserve(script.ticks);
+    size_t nextEvent = 0;
+    int mismatches = 0;
+
+    std::cout << "frame,tick,hash,render_us,golden\n";
+    for (uint32_t tick = 0; tick < script.ticks; ++tick)
+    {
+        for (; nextEvent < script.events.size() && script.events[nextEvent].tick == tick; ++nextEvent)
+        {
+            switch (script.events[nextEvent].command)
+            {
+            case SCRIPT_UP:
+                handleDirectionInput(game, 0, -1);
+                break;
+            case SCRIPT_DOWN:
+                handleDirectionInput(game, 0, 1);
+                break;
+            case SCRIPT_LEFT:
+                handleDirectionInput(game, -1, 0);
+                break;
+            case SCRIPT_RIGHT:
+                handleDirectionInput(game, 1, 0);
+                break;
+            case SCRIPT_RESTART:
+                restartLevel(game, levelArena, level);
+                history.clear(game);
+                break;
+            case SCRIPT_REWIND:
+                history.rollback(game, ROLLBACK_SAVES);
+                break;
+            case SCRIPT_LOWRES:
+                lowRes = !lowRes && lowResTarget;
+                break;
+            case SCRIPT_HEAT:
+                cycleHeatOverlay(overlay);
+                break;
+            default:
+                break;
+            }
+        }
+
+        stepSimulation(game);
+        history.record(game);
+        writeSnapshot(game, tick + 1, snap);
+
+        // Mierzymy tylko rysowanie; SDL odkłada polecenia do flush,
+        // więc bez niego czas byłby zaniżony, a piksele nieaktualne
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        frameArena.reset();
+        if (tier < RENDER_TIER_NO_HUD || !hud.texture || snap.tick - hudTick >= GOVERNOR_HUD_TICKS)
+        {
+            updateScoreTexture(renderer, font, frameArena, hud, snap.score);
+            hudTick = snap.tick;
+        }
+        drawFrame(renderer, frameArena, hud, overlay, snap, lowRes ? lowResTarget : NULL, mesh,
+                  tier >= RENDER_TIER_CACHED ? &board : NULL);
+        SDL_RenderFlush(renderer);
+        uint64_t us = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+                          std::chrono::steady_clock::now() - start)
+                          .count();
+
+        uint64_t hash = hashFramePixels(surface->pixels, surface->w, surface->h, surface->pitch);
+        size_t frame = hashes.size();
+        const char *status = "-";
+        if (compare)
+        {
+            if (frame >= golden.size())
+                status = "missing";
+            else if (golden[frame] != hash)
+                status = "DIFF";
+            else
+                status = "ok";
+            if (status[0] != 'o')
+                mismatches++;
+        }
+        hashes.push_back(hash);
+        times.push_back(us);
+        std::printf("%zu,%u,%016llx,%llu,%s\n", frame, (unsigned)(tick + 1), (unsigned long long)hash,
+                    (unsigned long long)us, status);
+    }
+
+    uint64_t total = 0;
+    for (uint64_t us : times)
+        total += us;
+    std::printf("# klatki %zu, średni czas %llu us, p50 %llu us, p99 %llu us, max %llu us\n", times.size(),
+                (unsigned long long)(times.empty() ? 0 : total / times.size()),
+                (unsigned long long)renderTimePercentile(times, 50),
+                (unsigned long long)renderTimePercentile(times, 99),
+                (unsigned long long)renderTimePercentile(times, 100));
+    if (compare)
+    {
+        if (golden.size() > hashes.size())
+            mismatches += (int)(golden.size() - hashes.size());
+        std::printf("# różne klatki: %d z %zu\n", mismatches, golden.size() > hashes.size() ? golden.size() : hashes.size());
+    }
+    else if (updateGolden && !saveGoldenHashes(goldenPath, hashes))
+        mismatches = 1;
+
+    if (hud.texture)
+        SDL_DestroyTexture(hud.texture);
+    if (board.texture)
+        SDL_DestroyTexture(board.texture);
+    if (lowResTarget)
+        SDL_DestroyTexture(lowResTarget);
+    SDL_DestroyRenderer(renderer);
     SDL_FreeSurface(surface);
-    SDL_DestroyTexture(texture);
+    return mismatches > 0 ? 1 : 0;
 }
 
 // GŁÓWNA PĘTLA PROGRAMU-----------------------------------------------------
 int main(int argc, char *argv[])
 {
+    // Licznik alokacji (debug) musi być przed pierwszą alokacją SDL
+    installAllocationCounter();
+
+    // Tryb niskiej rozdzielczości (--lowres albo F2)
+    bool lowRes = false;
+    // Plansza wbudowana (include/Levels.h) albo z paczki (--pack PLIK,
+    // include/LevelPack.h), --level N liczone od 0 (jak level_pack -x)
+    int levelIndex = 0;
+    const char *levelArg = "0"; // do komunikatu o złym numerze
+    const char *packPath = nullptr;
+    // Nagrywanie (--capture PLIK albo F3); .y4m - jeden plik wideo, inaczej sekwencja PPM
+    std::string capturePath = "capture.y4m";
+    bool captureAtStart = false;
+    HeatOverlay overlay;
+    // Metryki dla metrics_top (--metrics [NAZWA], ta sama nazwa co metrics_top -n);
+    // bez tego liczone tylko lokalnie
+    MetricsRegistry metrics;
+    const char *metricsName = nullptr;
+    // Test renderowania bez okna (--render-test SKRYPT [--golden PLIK] [--update-golden])
+    const char *renderTestPath = nullptr;
+    const char *goldenPath = nullptr;
+    bool updateGolden = false;
+    // Stały poziom jakości rysowania (--tier 0..3, FrameGovernor.h); -1 - automatycznie
+    int forcedTier = -1;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!std::strcmp(argv[i], "--lowres"))
+            lowRes = true;
+        else if (!std::strcmp(argv[i], "--metrics"))
+        {
+            metricsName = METRICS_SHM_NAME;
+            if (i + 1 < argc && argv[i + 1][0] != '-')
+                metricsName = argv[++i];
+        }
+        else if (!std::strcmp(argv[i], "--level") && i + 1 < argc)
+        {
+            // Cały argument musi być liczbą ("abc", "1x" - błąd, nie plansza 0/1)
+            levelArg = argv[++i];
+            char *end = nullptr;
+            errno = 0;
+            long value = std::strtol(levelArg, &end, 10);
+            bool number = end != levelArg && *end == '\0' && errno == 0;
+            levelIndex = number && value >= 0 && value <= INT_MAX ? (int)value : -1;
+        }
+        else if (!std::strcmp(argv[i], "--pack") && i + 1 < argc)
+            packPath = argv[++i];
+        else if (!std::strcmp(argv[i], "--capture") && i + 1 < argc)
+        {
+            capturePath = argv[++i];
+            captureAtStart = true;
+        }
+        else if (!std::strcmp(argv[i], "--render-test") && i + 1 < argc)
+            renderTestPath = argv[++i];
+        else if (!std::strcmp(argv[i], "--golden") && i + 1 < argc)
+            goldenPath = argv[++i];
+        else if (!std::strcmp(argv[i], "--update-golden"))
+            updateGolden = true;
+        else if (!std::strcmp(argv[i], "--tier") && i + 1 < argc)
+            forcedTier = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--heatmap") && i + 1 < argc)
+        {
+            if (loadHeatmap(argv[++i], overlay.map))
+                std::cout << "[HEATMAP] " << overlay.map.runs << " przebiegow, F4 - warstwy\n";
+            else
+                std::cerr << "Cannot load heatmap: " << argv[i] << std::endl;
+        }
+    }
+
+    // Segment zajęty przez inną grę - nie startujemy (liczniki by się mieszały)
+    if (metricsName && !metrics.publish(metricsName, SIM_TICK_RATE))
+        return 1;
+
+    // Plansza na całą sesję w płaskiej kopii (z paczki rozpakowana tylko ta jedna)
+    std::vector<uint8_t> levelTiles;
+    TileGrid level;
+    if (packPath)
+    {
+        LevelPack pack;
+        if (!pack.open(packPath))
+            return 1;
+        if (levelIndex < 0 || levelIndex >= pack.size())
+        {
+            std::cerr << "No level " << levelArg << " in " << packPath << " (0.." << pack.size() - 1 << ")"
+                      << std::endl;
+            return 1;
+        }
+        const TileGrid *packed = pack.level(levelIndex);
+        if (!packed)
+            return 1;
+        if (packed->width <= START_CELL_X || packed->height <= START_CELL_Y)
+        {
+            std::cerr << "Level " << levelIndex << " in " << packPath << " has no start cell" << std::endl;
+            return 1;
+        }
+        // Migawka dla renderowania ma stały rozmiar - większa plansza byłaby
+        // po cichu obcięta, a gracz i pantery wychodziliby poza obraz
+        if (packed->width > SNAPSHOT_MAX_WIDTH || packed->height > SNAPSHOT_MAX_HEIGHT)
+        {
+            std::cerr << "Level " << levelIndex << " in " << packPath << " is " << packed->width << "x"
+                      << packed->height << ", the game shows at most " << SNAPSHOT_MAX_WIDTH << "x"
+                      << SNAPSHOT_MAX_HEIGHT << std::endl;
+            return 1;
+        }
+        level = flattenMaze(*packed, levelTiles);
+        const LevelPackEntry &info = pack.entry(levelIndex);
+        std::cout << "[DEBUG] Plansza " << levelIndex << " z " << pack.size() << ": " << info.name
+                  << " (trudność " << (int)info.difficulty << ", złoto " << info.goldUnits << ")\n";
+    }
+    else
+    {
+        if (levelIndex < 0 || levelIndex >= BUILTIN_LEVEL_COUNT)
+        {
+            std::cerr << "No built-in level " << levelArg << " (0.." << BUILTIN_LEVEL_COUNT - 1 << ")"
+                      << std::endl;
+            return 1;
+        }
+        level = flattenMaze(BUILTIN_LEVELS[levelIndex], levelTiles);
+    }
 
-    // Labirynt 1 (1=ściana, 0=ścieżka, 5=życie, 4 - złoto, 3 - złoto podwójne)
-    std::vector<std::vector<int>> maze2 = {
-        {5, 5, 5, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 1, 1},
-        {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 1, 1},
-        {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 1, 1},
-        {1, 0, 0, 0, 0, 0, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1},
-        {1, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 1, 1, 1, 1, 1, 1, 1, 0, 1, 0, 1},
-        {1, 0, 1, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 1},
-        {1, 0, 1, 0, 1, 1, 1, 0, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 0, 1},
-        {1, 0, 1, 0, 1, 1, 1, 0, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 0, 1},
-        {1, 0, 1, 0, 0, 0, 0, 0, 0, 1, 0, 1, 1, 1, 0, 1, 1, 0, 0, 1, 0, 1},
-        {1, 0, 1, 1, 1, 1, 1, 1, 0, 1, 0, 0, 0, 1, 0, 1, 0, 0, 1, 1, 0, 1},
-        {1, 0, 0, 0, 0, 4, 3, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0, 1, 1, 0, 0, 1},
-        {1, 0, 0, 1, 1, 1, 1, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0, 1, 1, 0, 1, 1},
-        {1, 0, 0, 0, 0, 4, 3, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0, 1, 1, 0, 0, 1},
-        {1, 0, 0, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1, 1, 0, 1},
-        {1, 0, 0, 0, 0, 4, 3, 1, 0, 1, 0, 1, 1, 0, 1, 1, 1, 0, 0, 0, 0, 1},
-        {1, 0, 1, 1, 1, 1, 1, 1, 0, 1, 0, 1, 1, 0, 1, 1, 1, 0, 1, 1, 0, 1},
-        {1, 0, 0, 0, 0, 0, 1, 1, 0, 1, 0, 1, 1, 0, 1, 1, 1, 0, 1, 1, 0, 1},
-        {1, 1, 0, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 0, 1},
-        {1, 1, 0, 1, 1, 0, 1, 1, 0, 1, 1, 0, 1, 0, 1, 1, 1, 1, 1, 1, 0, 1},
-        {1, 1, 0, 1, 1, 0, 1, 1, 0, 1, 1, 0, 1, 0, 0, 0, 0, 0, 1, 1, 0, 1},
-        {1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 0, 0, 0, 0, 1},
-        {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1},
-        {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1},
-        {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1}};
-
-    // Szablon labiryntu
-    std::vector<std::vector<int>> templateMaze = {
-        {5, 5, 5, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 1, 1},
-        {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 1, 1},
-        {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 1, 1},
-        {1, 0, 0, 0, 0, 0, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1},
-        {1, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 1, 1, 1, 1, 1, 1, 1, 0, 1, 0, 1},
-        {1, 0, 1, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 1},
-        {1, 0, 1, 0, 1, 1, 1, 0, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 0, 1},
-        {1, 0, 1, 0, 1, 1, 1, 0, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 0, 1},
-        {1, 0, 1, 0, 0, 0, 0, 0, 0, 1, 0, 1, 1, 1, 0, 1, 1, 0, 0, 1, 0, 1},
-        {1, 0, 1, 1, 1, 1, 1, 1, 0, 1, 0, 0, 0, 1, 0, 1, 0, 0, 1, 1, 0, 1},
-        {1, 0, 0, 0, 0, 4, 3, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0, 1, 1, 0, 0, 1},
-        {1, 0, 0, 1, 1, 1, 1, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0, 1, 1, 0, 1, 1},
-        {1, 0, 0, 0, 0, 4, 3, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0, 1, 1, 0, 0, 1},
-        {1, 0, 0, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1, 1, 0, 1},
-        {1, 0, 0, 0, 0, 4, 3, 1, 0, 1, 0, 1, 1, 0, 1, 1, 1, 0, 0, 0, 0, 1},
-        {1, 0, 1, 1, 1, 1, 1, 1, 0, 1, 0, 1, 1, 0, 1, 1, 1, 0, 1, 1, 0, 1},
-        {1, 0, 0, 0, 0, 0, 1, 1, 0, 1, 0, 1, 1, 0, 1, 1, 1, 0, 1, 1, 0, 1},
-        {1, 1, 0, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 0, 1},
-        {1, 1, 0, 1, 1, 0, 1, 1, 0, 1, 1, 0, 1, 0, 1, 1, 1, 1, 1, 1, 0, 1},
-        {1, 1, 0, 1, 1, 0, 1, 1, 0, 1, 1, 0, 1, 0, 0, 0, 0, 0, 1, 1, 0, 1},
-        {1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 0, 0, 0, 0, 1},
-        {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1},
-        {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1}};
-
-    // Licznik punktów, flaga złota
-    int score = 0;
-    bool hasGold = false;
-
-    // Inicjalizacja SDL
-    if (SDL_Init(SDL_INIT_VIDEO) < 0)
+    // Inicjalizacja SDL (test renderowania nie potrzebuje wideo ani ekranu)
+    if (SDL_Init(renderTestPath ? 0 : SDL_INIT_VIDEO) < 0)
     {
         std::cerr << "SDL initialization failed: " << SDL_GetError() << std::endl;
         return 1;
@@ -641,6 +1201,16 @@ int main(int argc, char *argv[])
         return 1;
     }
 
+    if (renderTestPath)
+    {
+        int result = runRenderTest(font, level, overlay, lowRes, forcedTier, renderTestPath, goldenPath,
+                                   updateGolden);
+        TTF_CloseFont(font);
+        TTF_Quit();
+        SDL_Quit();
+        return result;
+    }
+
     // Okno
     SDL_Window *window = SDL_CreateWindow(
         "Raid on Fort Knox - Pixel sprite",
@@ -648,7 +1218,7 @@ int main(int argc, char *argv[])
         SDL_WINDOWPOS_CENTERED,
         WINDOW_WIDTH,
         WINDOW_HEIGHT,
-        SDL_WINDOW_SHOWN);
+        SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE);
     if (!window)
     {
         std::cerr << "Window creation failed: " << SDL_GetError() << std::endl;
@@ -668,362 +1238,270 @@ int main(int argc, char *argv[])
         return 1;
     }
 
-    // Labirynt 1 (1=ściana, 0=ścieżka, 5=życie, 4 - złoto, 3 - złoto podwójne)
-    std::vector<std::vector<int>> maze = {
-
-        {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 1, 1},
-        {1, 3, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 1},
-        {1, 0, 1, 0, 1, 1, 1, 1, 1, 0, 1, 1, 1, 0, 1, 0, 1, 1, 1, 0, 1, 1},
-        {1, 0, 1, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 1},
-        {1, 0, 1, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 1, 1, 1, 1, 0, 1, 0, 1, 1},
-        {1, 0, 1, 0, 1, 0, 1, 0, 0, 0, 1, 0, 1, 0, 0, 0, 0, 0, 1, 0, 1, 1},
-        {1, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 0, 1, 0, 1, 1, 1, 1, 1, 0, 1, 1},
-        {1, 0, 0, 0, 1, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 1},
-        {1, 0, 1, 1, 1, 0, 1, 1, 0, 1, 1, 1, 1, 1, 1, 0, 1, 0, 1, 1, 1, 1},
-        {1, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 1},
-        {1, 0, 1, 0, 1, 1, 1, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 1, 1},
-        {1, 4, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 4, 1, 0, 0, 0, 1, 0, 1, 1},
-        {1, 1, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 1, 1, 0, 1, 0, 1, 0, 1, 1},
-        {1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 1},
-        {1, 0, 1, 1, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1},
-        {1, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 1},
-        {1, 0, 1, 0, 1, 1, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 0, 1, 1},
-        {1, 0, 0, 0, 1, 0, 1, 0, 0, 0, 1, 3, 0, 0, 1, 0, 0, 0, 1, 0, 1, 1},
-        {1, 0, 1, 1, 1, 0, 1, 0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 1, 1},
-        {1, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 1, 1},
-        {1, 0, 1, 1, 1, 0, 1, 1, 1, 1, 1, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 1},
-        {1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 1},
-        {1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 1},
-        {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1}
-
-    };
-
-    // Startowa pozycja (wycentrowana w kafelku 19,1)
-    posPlayerX = 19.0f * CELL_SIZE + (CELL_SIZE - PLAYER_WIDTH) / 2.0f;
-    posPlayerY = 1.0f * CELL_SIZE + (CELL_SIZE - PLAYER_HEIGHT) / 2.0f;
-
-    posStartX = 19.0f * CELL_SIZE + (CELL_SIZE - GOLD_WIDTH) / 2.0f;
-    posStartY = 0.0f * CELL_SIZE + (CELL_SIZE - GOLD_HEIGHT) / 2.0f;
-
-    // Początkowo stoimy w miejscu
-    targetPlayerPosX = posPlayerX;
-    targetPlayerPosY = posPlayerY;
-
-    bool running = true;
+    // Tekstura trybu niskiej rozdzielczości; skalowanie "nearest"
+    SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "0");
+    SDL_Texture *lowResTarget = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                                                  level.width * LOWRES_TILE, level.height * LOWRES_TILE);
+    if (!lowResTarget)
+    {
+        std::cerr << "Low-res render target unavailable: " << SDL_GetError() << std::endl;
+        lowRes = false;
+    }
+
+    // Cały stan poziomu w jednej arenie; restart to jej reset
+    Arena levelArena(levelArenaBytes(level.width, level.height, 1));
+    GameState game;
+    game.turnBufferTicks = TURN_BUFFER_TICKS;
+    if (!initGameState(game, levelArena, level))
+    {
+        std::cerr << "Level arena too small" << std::endl;
+        SDL_DestroyRenderer(renderer);
+        SDL_DestroyWindow(window);
+        TTF_CloseFont(font);
+        TTF_Quit();
+        SDL_Quit();
+        return 1;
+    }
+
+    // Migawki świata: symulacja pisze, renderowanie czyta najnowszą
+    TripleBuffer<WorldSnapshot> snapshots;
+    writeSnapshot(game, 0, snapshots.writeBuffer());
+    snapshots.publish();
+
+    SpscQueue<PlayerCommand, 64> input;
+    std::atomic<bool> running(true);
+    std::atomic<bool> simPaused(false);
+
+    std::thread simThread(runSimulation, std::ref(game), std::ref(levelArena), std::cref(level),
+                          std::ref(input), std::ref(snapshots), std::ref(metrics), std::ref(running),
+                          std::ref(simPaused));
+
+    Arena frameArena(FRAME_ARENA_SIZE);
+    ScoreTexture hud;
+    unsigned frameCount = 0;
+
+    // Regulator jakości: budżet klatki to jeden krok symulacji
+    FrameGovernor governor(1000000 / SIM_TICK_RATE);
+    governor.force(forcedTier);
+    metrics.tier(governor.tier());
+    BoardCache board;
+    BoardMesh mesh(boardMeshWorkers());
+    uint32_t hudTick = 0;
+    uint32_t presentedTick = 0;
+    uint32_t capturedTick = 0; // 0 - nagrywanie dopiero ruszyło
+
+    FrameCapture capture;
+    if (captureAtStart)
+        startCapture(capture, renderer, capturePath);
+
     SDL_Event event;
+    std::chrono::steady_clock::time_point frameStart = std::chrono::steady_clock::now();
+
+    // Pętla oszczędna: klatka jest rysowana tylko wtedy, gdy jest nowy krok
+    // symulacji albo coś innego zmieniło obraz (redraw). W pauzie (P) i przy
+    // zminimalizowanym/ukrytym oknie symulacja stoi, a pętla czeka na zdarzenie.
+    bool paused = false;
+    bool hidden = false;
+    bool redraw = true;
+    bool idleSincePresent = false;
+    uint32_t shownInputStamp = 0;
+    std::chrono::steady_clock::time_point cpuSampleTime = frameStart;
 
     while (running)
     {
-        // 1) Obsługa zdarzeń
-        while (SDL_PollEvent(&event))
+        unsigned long long allocationsBefore = heapAllocations();
+        bool expectAllocations = false;
+        frameArena.reset();
+
+        // 1) Obsługa zdarzeń - polecenia idą do wątku symulacji
+        bool idle = (paused || hidden) && !redraw;
+        if (idle)
+            idleSincePresent = true;
+        for (int got = idle ? SDL_WaitEventTimeout(&event, IDLE_WAIT_MS) : SDL_PollEvent(&event); got;
+             got = SDL_PollEvent(&event))
         {
             if (event.type == SDL_QUIT)
             {
                 running = false;
             }
-            else if (event.type == SDL_KEYDOWN)
+            else if (event.type == SDL_WINDOWEVENT)
             {
-                // Określamy aktualną komórkę (środek gracza)
-                int cellX = (int)((posPlayerX + PLAYER_WIDTH / 2) / CELL_SIZE);
-                int cellY = (int)((posPlayerY + PLAYER_HEIGHT / 2) / CELL_SIZE);
-
-                if (event.key.keysym.sym == SDLK_UP || event.key.keysym.sym == SDLK_DOWN)
+                switch (event.window.event)
                 {
-                    // Snapujemy w osi X (wyśrodkowujemy)
-                    float centerX = cellX * CELL_SIZE + CELL_SIZE / 2.0f;
-                    posPlayerX = centerX - PLAYER_WIDTH / 2.0f;
-
-                    // Kierunek
-                    dirCellX = 0;
-                    dirCellY = (event.key.keysym.sym == SDLK_UP) ? -1 : 1;
+                case SDL_WINDOWEVENT_MINIMIZED:
+                case SDL_WINDOWEVENT_HIDDEN:
+                    hidden = true;
+                    break;
+                case SDL_WINDOWEVENT_RESTORED:
+                case SDL_WINDOWEVENT_MAXIMIZED:
+                case SDL_WINDOWEVENT_SHOWN:
+                    hidden = false;
+                    redraw = true;
+                    break;
+                case SDL_WINDOWEVENT_EXPOSED:
+                case SDL_WINDOWEVENT_SIZE_CHANGED:
+                    redraw = true;
+                    break;
+                default:
+                    break;
                 }
-                else if (event.key.keysym.sym == SDLK_LEFT || event.key.keysym.sym == SDLK_RIGHT)
-                {
-                    // Snapujemy w osi Y
-                    float centerY = cellY * CELL_SIZE + CELL_SIZE / 2.0f;
-                    posPlayerY = centerY - PLAYER_HEIGHT / 2.0f;
-
-                    dirCellY = 0;
-                    dirCellX = (event.key.keysym.sym == SDLK_LEFT) ? -1 : 1;
-                }
-                else
-                {
-                    // np. spacja, ESC, itp. - ignorujemy
-                    continue;
-                }
-
-                // Teraz obliczamy docelową komórkę
-                cellX = (int)((posPlayerX + PLAYER_WIDTH / 2) / CELL_SIZE);
-                cellY = (int)((posPlayerY + PLAYER_HEIGHT / 2) / CELL_SIZE);
-
-                int tCellX, tCellY;
-                computeTargetCell(maze, cellX, cellY, dirCellX, dirCellY, tCellX, tCellY);
-
-                // Zamieniamy na piksele (też wycentrowane)
-                targetPlayerPosX = tCellX * CELL_SIZE + (CELL_SIZE - PLAYER_WIDTH) / 2.0f;
-                targetPlayerPosY = tCellY * CELL_SIZE + (CELL_SIZE - PLAYER_HEIGHT) / 2.0f;
-
-                isMoving = true;
             }
-        }
-
-        // 2) Logika płynnego ruchu
-        if (isMoving)
-        {
-            float dx = targetPlayerPosX - posPlayerX;
-            float dy = targetPlayerPosY - posPlayerY;
-            float dist = std::sqrt(dx * dx + dy * dy);
-
-            if (dist > speed)
-            {
-                float stepX = posPlayerX + speed * (dx / dist);
-                float stepY = posPlayerY + speed * (dy / dist);
-
-                // Sprawdzamy kolizję - wąski korytarz, raczej i tak jej nie będzie,
-                // ale zostawiamy "na wszelki wypadek".
-                if (!checkCollisionWithWalls(stepX, stepY, maze))
-                {
-                    posPlayerX = stepX;
-                    posPlayerY = stepY;
-                }
-                else
-                {
-                    // Kolizja - zatrzymujemy ruch
-                    isMoving = false;
-                }
-            }
-            else
+            else if (event.type == SDL_KEYDOWN)
             {
-                // Ostatni krok
-                float stepX = targetPlayerPosX;
-                float stepY = targetPlayerPosY;
-
-                if (!checkCollisionWithWalls(stepX, stepY, maze))
+                PlayerCommand cmd;
+                if (event.key.keysym.sym == SDLK_p)
                 {
-                    posPlayerX = stepX;
-                    posPlayerY = stepY;
+                    paused = !paused;
+                    std::cout << (paused ? "[DEBUG] Pauza\n" : "[DEBUG] Koniec pauzy\n");
+                    continue;
                 }
-                isMoving = false;
-            }
-            if (pantherIsDisabled)
-            {
-                pantherDisableTimer--;
-                if (pantherDisableTimer <= 0)
+                if (event.key.keysym.sym == SDLK_F2)
                 {
-                    pantherIsDisabled = false;
-                    std::cout << "[DEBUG] Pantera znowu niebezpieczna.\n";
+                    lowRes = !lowRes && lowResTarget;
+                    redraw = true;
+                    continue;
                 }
-            }
-        }
-
-        // 3) Sprawdzamy, czy zbieramy złoto / wejście na start
-        {
-            int checkCellX = (int)((posPlayerX + PLAYER_WIDTH / 2) / CELL_SIZE);
-            int checkCellY = (int)((posPlayerY + PLAYER_HEIGHT / 2) / CELL_SIZE);
-
-            if (checkCellY >= 0 && checkCellY < (int)maze.size() &&
-                checkCellX >= 0 && checkCellX < (int)maze[checkCellY].size())
-            {
-                int cellValue = maze[checkCellY][checkCellX];
-                if (cellValue == 4)
+                if (event.key.keysym.sym == SDLK_F4)
                 {
-
-                    if (hasGold)
-                    {
-                        isMoving = false;
-                    }
-                    else if (!hasGold)
-                    {
-                        std::cout << "Zbierasz zloto pojedyncze\n";
-                        maze[checkCellY][checkCellX] = 0;
-                        hasGold = true;
-                        if (hasGold)
-                        {
-                            isMoving = false;
-                        }
-                    }
+                    cycleHeatOverlay(overlay);
+                    redraw = true;
+                    continue;
                 }
-                else if (cellValue == 3)
+                if (event.key.keysym.sym == SDLK_F3)
                 {
-                    if (hasGold)
-                    {
-                        isMoving = false;
-                    }
-                    else if (!hasGold)
-                    {
-                        std::cout << "Zbierasz zloto podwojne\n";
-                        maze[checkCellY][checkCellX] = 4;
-                        hasGold = true;
-                        if (hasGold)
-                        {
-                            isMoving = false;
-                        }
-                    }
+                    if (capture.isActive())
+                        capture.stop();
+                    else if (startCapture(capture, renderer, capturePath))
+                        capturedTick = 0;
+                    expectAllocations = true;
+                    continue;
                 }
-                // kolizja ze startem
-                if (checkStartBoxCollision(posPlayerX, posPlayerY, PLAYER_WIDTH, PLAYER_HEIGHT,
-                                           posStartX, posStartY, START_WIDTH, START_HEIGHT))
+                cmd.timestamp = event.key.timestamp;
+                if (event.key.keysym.sym == SDLK_r)
                 {
-                    if (hasGold)
-                    {
-                        std::cout << "Oddajesz zloto na start!\n";
-                        score++;
-                        hasGold = false;
-                    }
-                    else
-                    {
-                        std::cout << "Nie masz złota!\n";
-                    }
+                    cmd.restart = true;
                 }
-                else if (cellValue == 5)
+                else if (event.key.keysym.sym == SDLK_BACKSPACE)
                 {
-                    // Tu np. mechanika życia
+                    cmd.rewind = true;
                 }
-
-                if (!pantherIsDisabled)
+                else if (!directionForKey(event.key.keysym.sym, cmd.dirX, cmd.dirY))
                 {
-                    // Kolizja z panterą
-                    if (checkPantherBoxCollision(posPlayerX, posPlayerY, PLAYER_WIDTH, PLAYER_HEIGHT,
-                                                 posPantherX, posPantherY, PANTHER_WIDTH, PANTHER_HEIGHT))
-                    {
-                        if (!justCollidedWithPanther)
-                        {
-                            if (hasGold)
-                            {
-                                justCollidedWithPanther = true;
-                                pantherIsDisabled = true;
-                                pantherDisableTimer = PANTHER_DISABLE_TIME;
-                                std::cout << "Złapała Cię pantera. Tracisz złoto!\n";
-                                hasGold = false;
-                            }
-                            else
-                            {
-                                std::cout << "Złapała Cię pantera. Tracisz życie!\n";
-                                // Usuwasz jedno życie z labiryntu lub zmniejszasz licznik "lives"
-                                maze[0][2] = 0;
-                            }
-                        }
-                        else
-                        {
-                            // tu "else" jest wobec warunku cellValue == 7
-                            // tzn. jeżeli to *nie* pantera, to znaczy, że gracz stoi gdzieś indziej
-                            // i można zresetować justCollidedWithPanther
-                            justCollidedWithPanther = false;
-                        }
-                    }
-                    /////////////////////////// ruszanie pantery
-                    // Przesunięcie pantery w bieżącym kierunku
-                    posPantherX += pantherSpeed * pantherDirX; // Ruch w poziomie
-                    posPantherY += pantherSpeed * pantherDirY; // Ruch w pionie
-
-                    /* // Sprawdzanie kolizji z korytarzem (ścianami)
-                     int cellX = (int)(posPantherX / CELL_SIZE); // Pozycja w siatce
-                     int cellY = (int)(posPantherY / CELL_SIZE);
-
-                     // Jeśli pantera napotka ścianę, zmień kierunek
-                     if (maze[cellY][cellX] == 1) { // 1 = ściana
-                     if (pantherDirX != 0) { // Porusza się w poziomie
-                     pantherDirX *= -1; // Zmiana kierunku na osi X
-                     } else if (pantherDirY != 0) { // Porusza się w pionie
-                     pantherDirY *= -1; // Zmiana kierunku na osi Y
-                     }
-                 }
-                     */
-                    ////////////////////////////////////////// koniec ruszanie pantery
-
-                    // Jeśli pantera napotka ścianę, zmień kierunek
-                    if (checkPantherCollisionWithWalls(posPantherX, posPantherY, maze))
-                    {
-                        if (pantherDirX != 0)
-                        {                                              // Porusza się w poziomie
-                            pantherDirX *= -1;                         // Zmiana kierunku na osi X
-                            posPantherX += pantherSpeed * pantherDirX; // Cofnięcie o krok
-                        }
-                        else if (pantherDirY != 0)
-                        {                                              // Porusza się w pionie
-                            pantherDirY *= -1;                         // Zmiana kierunku na osi Y
-                            posPantherY += pantherSpeed * pantherDirY; // Cofnięcie o krok
-                        }
-                    }
+                    // np. spacja, ESC, itp. - ignorujemy
+                    continue;
                 }
+                input.push(cmd);
             }
         }
-        // 4) Renderowanie
-        SDL_SetRenderDrawColor(renderer, COLOR_PATH.r, COLOR_PATH.g, COLOR_PATH.b, COLOR_PATH.a);
-        SDL_RenderClear(renderer);
 
-        // Rysowanie labiryntu
-        for (size_t y = 0; y < maze.size(); ++y)
+        // Symulacja stoi w pauzie i przy ukrytym oknie
+        if (simPaused.load() != (paused || hidden))
         {
-            for (size_t x = 0; x < maze[y].size(); ++x)
-            {
-                int val = maze[y][x];
-                if (val == 1)
-                {
-                    drawRect(renderer, x * CELL_SIZE, y * CELL_SIZE, CELL_SIZE, CELL_SIZE, COLOR_WALL);
-                }
-                else if (val == 4)
-                {
-                    drawGoldSprite(renderer, x * CELL_SIZE, y * CELL_SIZE);
-                }
-                else if (val == 3)
-                {
-                    drawGold2Sprite(renderer, x * CELL_SIZE, y * CELL_SIZE);
-                }
-                else if (val == 5)
-                {
-                    drawRect(renderer, x * CELL_SIZE, y * CELL_SIZE, CELL_SIZE, CELL_SIZE, COLOR_LIVES);
-                } // else if (val == 6) {
-                  // drawRect(renderer, x * CELL_SIZE, y * CELL_SIZE, CELL_SIZE, CELL_SIZE, COLOR_START);
-                //}
-                else
-                {
-                    drawRect(renderer, x * CELL_SIZE, y * CELL_SIZE, CELL_SIZE, CELL_SIZE, COLOR_PATH);
-                }
-            }
+            simPaused.store(paused || hidden);
+            simPaused.notify_one();
         }
 
-        // Rysowanie punktów
-        std::string scoreText = "Punkty: " + std::to_string(score);
-        renderText(renderer, font, scoreText, 5 * CELL_SIZE, 0, {255, 255, 255, 255});
-
-        // *** RYSOWANIE GRACZA: pixel-art sprite ***
+        // Czas procesora co sekundę (metrics_top: kolumna cpu)
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (now - cpuSampleTime >= std::chrono::seconds(1))
+        {
+            metrics.cpu(processCpuTimeUs(), paused || hidden);
+            cpuSampleTime = now;
+        }
 
-        // sprawdzamy, czy gracz idzie w lewo, prawo, górę, dół
-        if (!isMoving)
+        // 2) Renderowanie najnowszej migawki - tylko gdy obraz się zmienił
+        bool newTick = false;
+        const WorldSnapshot &snap = snapshots.readNewest(&newTick);
+        RenderTier tier = governor.tier();
+        // Od RENDER_TIER_HALF_RATE pokazujemy co drugi krok (symulacja idzie dalej)
+        if (newTick && !redraw && tier >= RENDER_TIER_HALF_RATE && snap.tick - presentedTick < 2)
+            newTick = false;
+        if (!newTick && !redraw)
         {
-            drawPlayerSprite(renderer, posPlayerX, posPlayerY);
+            if (!(paused || hidden))
+                SDL_Delay(FRAME_POLL_DELAY_MS);
+            continue;
         }
-        else if (dirCellX == 1)
+        redraw = false;
+        std::chrono::steady_clock::time_point workStart = std::chrono::steady_clock::now();
+        if (tier < RENDER_TIER_NO_HUD || !hud.texture || snap.tick - hudTick >= GOVERNOR_HUD_TICKS)
         {
-            drawPlayerSpriteRight(renderer, posPlayerX, posPlayerY);
+            if (updateScoreTexture(renderer, font, frameArena, hud, snap.score))
+                expectAllocations = true;
+            hudTick = snap.tick;
         }
-        else if (dirCellX == -1)
+        if (tier >= RENDER_TIER_CACHED && !board.texture)
+            expectAllocations = true; // pierwsza tekstura planszy
+        drawFrame(renderer, frameArena, hud, overlay, snap, lowRes ? lowResTarget : NULL, mesh,
+                  tier >= RENDER_TIER_CACHED ? &board : NULL);
+
+        // Wideo ma stałe SIM_TICK_RATE kl/s: klatka pokazująca kilka kroków
+        // (nadrabianie, co druga klatka, pominięte nagranie) zapisuje się tyle
+        // razy, ile kroków minęło; odczyt musi być przed SDL_RenderPresent
+        if (capture.isActive() && snap.tick != capturedTick)
         {
-            drawPlayerSpriteLeft(renderer, posPlayerX, posPlayerY);
+            int ticks = capturedTick ? (int)std::min<uint32_t>(snap.tick - capturedTick, SIM_TICK_RATE) : 1;
+            if (capture.grab(renderer, ticks))
+                capturedTick = snap.tick;
         }
-        else if (dirCellY == 1)
+
+        // Czas pracy klatki dla regulatora - przed SDL_RenderPresent, bo ten
+        // może czekać na vsync (wymuszony przez sterownik albo kompozytor),
+        // a czekanie to nie przeciążenie
+        uint64_t workUs = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+                              std::chrono::steady_clock::now() - workStart)
+                              .count();
+
+        // Wyświetlanie (może czekać na vsync - symulacja i tak idzie swoim tempem)
+        SDL_RenderPresent(renderer);
+        presentedTick = snap.tick;
+
+        if (governor.frame(workUs))
         {
-            drawPlayerSpriteDown(renderer, posPlayerX, posPlayerY);
+            std::cout << "[DEBUG] Jakość renderowania: " << RENDER_TIER_NAMES[governor.tier()] << " (klatka "
+                      << governor.averageUs() << " us)\n";
+            metrics.tier(governor.tier());
+            expectAllocations = true;
         }
-        else if (dirCellY == -1)
+
+        // Pierwsza pokazana klatka z ruchem po strzałce: opóźnienie od zdarzenia SDL
+        if (snap.inputStamp != shownInputStamp)
         {
-            drawPlayerSprite(renderer, posPlayerX, posPlayerY);
-            //} else {
-            // drawPlayerSprite(renderer, posPlayerX, posPlayerY);
+            shownInputStamp = snap.inputStamp;
+            metrics.inputLatency((uint64_t)(SDL_GetTicks() - snap.inputStamp) * 1000);
         }
-        // Rysowanie pantery
-        drawPantherSprite(renderer, posPantherX, posPantherY, pantherIsDisabled);
 
-        drawStartSprite(renderer, 19 * CELL_SIZE, 0 * CELL_SIZE);
-        // Wyświetlanie
-        SDL_RenderPresent(renderer);
+        // W buildzie debug: klatka w stanie ustalonym nie powinna nic alokować
+        unsigned long long frameAllocations = heapAllocations() - allocationsBefore;
+        frameCount++;
+        if (frameAllocations > 0 && frameCount > ALLOC_WARMUP_FRAMES && !expectAllocations)
+        {
+            std::cout << "[DEBUG] Klatka " << frameCount << ": " << frameAllocations
+                      << " alokacji na stercie\n";
+        }
 
-        // Krótka pauza (~25 FPS)
-        SDL_Delay(10);
+        // Czas klatki od początku do początku, razem z czekaniem na krok i vsync
+        // (klatka po bezczynności się nie liczy - to czas czekania, nie rysowania)
+        std::chrono::steady_clock::time_point frameEnd = std::chrono::steady_clock::now();
+        if (!idleSincePresent)
+            metrics.frame((uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(frameEnd - frameStart).count());
+        idleSincePresent = false;
+        frameStart = frameEnd;
     }
 
+    // Wątek symulacji może spać w pauzie
+    simPaused.store(false);
+    simPaused.notify_one();
+    simThread.join();
+    capture.stop();
+
     // Sprzątanie
+    if (hud.texture)
+        SDL_DestroyTexture(hud.texture);
+    if (board.texture)
+        SDL_DestroyTexture(board.texture);
+    if (lowResTarget)
+        SDL_DestroyTexture(lowResTarget);
     TTF_CloseFont(font);
     TTF_Quit();
     SDL_DestroyRenderer(renderer);